@@ -0,0 +1,147 @@
+/*
+ELEKTRON © 2026 - now
+Written by melektron
+www.elektron.work
+17.10.26, 10:20
+All rights reserved.
+
+This source code is licensed under the Apache-2.0 license found in the
+LICENSE file in the root directory of this source tree.
+
+Example usage of universal_csv_reader and universal_csv_writer (sort of a test-like code).
+The program exits with a non-zero status if any check fails.
+*/
+
+#include <el/universal_csv.hpp>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+
+static int failures = 0;
+
+#define CHECK(cond) \
+    if (!(cond)) { std::printf("FAIL %s:%d: %s\r\n", __FILE__, __LINE__, #cond); failures++; } \
+    else std::printf("ok   %s\r\n", #cond)
+
+using el::universal;
+using el::universal_type_t;
+
+static std::vector<std::vector<universal>> read_all(el::universal_csv_reader &_reader)
+{
+    std::vector<std::vector<universal>> records;
+    std::vector<universal> record;
+    while (_reader.next(record))
+        records.push_back(record);
+    return records;
+}
+
+
+int main()
+{
+    std::printf("\r\n== type inference\r\n");
+    {
+        el::universal_csv_reader reader(std::string_view("1,-2.5,true,#ff8000,hello,,\"42\",1e3,nan\n"));
+        std::vector<universal> r;
+        CHECK(reader.next(r));
+        CHECK(r.size() == 9);
+        CHECK(r[0].get_type() == universal_type_t::integer && r[0] == 1);
+        CHECK(r[1].get_type() == universal_type_t::floating && r[1] == -2.5);
+        CHECK(r[2].get_type() == universal_type_t::boolean && r[2] == true);
+        CHECK(r[3].get_type() == universal_type_t::rgb24 && r[3] == el::types::rgb24_t(0xff, 0x80, 0x00));
+        CHECK(r[4].get_type() == universal_type_t::string && r[4] == "hello");
+        CHECK(r[5].get_type() == universal_type_t::empty);
+        CHECK(r[6].get_type() == universal_type_t::string && r[6] == "42");
+        CHECK(r[7].get_type() == universal_type_t::floating && r[7] == 1000.0);
+        CHECK(r[8].get_type() == universal_type_t::floating);
+        CHECK(!reader.next(r));
+        CHECK(!reader.error());
+        CHECK(reader.record_count() == 1);
+    }
+
+    std::printf("\r\n== round trip\r\n");
+    {
+        std::vector<std::vector<universal>> written = {
+            {universal(1), universal(2.0), universal("text")},
+            {universal("a,b"), universal("quote \" inside"), universal("line\nbreak")},
+            {universal("123"), universal("true"), universal(""), universal()},
+            {universal(false), universal(el::types::rgb24_t(0x12, 0x34, 0x56)), universal(-7)},
+        };
+        std::ostringstream out;
+        {
+            el::universal_csv_writer writer(out);
+            for (const auto &record : written)
+                writer.write_record(record);
+        }
+
+        std::istringstream in(out.str());
+        el::universal_csv_reader reader(in, ',', 8);     // tiny chunks to split records across refills
+        auto read = read_all(reader);
+        CHECK(!reader.error());
+        CHECK(read.size() == written.size());
+        bool same = read.size() == written.size();
+        for (size_t i = 0; same && i < read.size(); i++)
+        {
+            same = read[i].size() == written[i].size();
+            for (size_t j = 0; same && j < read[i].size(); j++)
+                same = read[i][j].get_type() == written[i][j].get_type() && read[i][j] == written[i][j];
+        }
+        CHECK(same);
+    }
+
+    std::printf("\r\n== empty records\r\n");
+    {
+        std::ostringstream out;
+        {
+            el::universal_csv_writer writer(out);
+            writer.write_record({universal(1)});
+            writer.write_record({universal()});
+            writer.write_record({universal(2)});
+        }
+        std::string text = out.str();
+        CHECK(text == "1\n\n2\n");
+
+        el::universal_csv_reader reader(text);
+        auto read = read_all(reader);
+        CHECK(read.size() == 3);
+        CHECK(read.size() == 3 && read[1].size() == 1 && read[1][0].get_type() == universal_type_t::empty);
+        CHECK(read.size() == 3 && read[2][0] == 2);
+
+        el::universal_csv_reader crlf(std::string_view("1\r\n\r\n2\r\n"));
+        CHECK(read_all(crlf).size() == 3);
+    }
+
+    std::printf("\r\n== malformed input\r\n");
+    {
+        el::universal_csv_reader reader(std::string_view("1,2\n\"unterminated,3\n"));
+        std::vector<universal> r;
+        CHECK(reader.next(r));
+        CHECK(!reader.next(r));
+        CHECK(reader.error());
+        CHECK(!reader.next(r));
+
+        std::istringstream in("a,b\n\"open");
+        el::universal_csv_reader stream_reader(in, ',', 4);
+        CHECK(read_all(stream_reader).size() == 1);
+        CHECK(stream_reader.error());
+    }
+
+    std::printf("\r\n== parallel reading\r\n");
+    {
+        std::string data;
+        for (int i = 0; i < 1000; i++)
+            data += std::to_string(i) + ",\"multi\nline\"\n";
+        std::vector<size_t> counts(4, 0);
+        std::vector<int64_t> sums(4, 0);
+        bool ok = el::universal_csv_reader::read_parallel(data, 4, [&](size_t _part, const std::vector<universal> &_record) {
+            counts[_part]++;
+            sums[_part] += _record[0].to_int64_t();
+        });
+        CHECK(ok);
+        CHECK(counts[0] + counts[1] + counts[2] + counts[3] == 1000);
+        CHECK(sums[0] + sums[1] + sums[2] + sums[3] == 999 * 1000 / 2);
+    }
+
+    std::printf("\r\n%s (%d failures)\r\n", failures ? "FAILED" : "PASSED", failures);
+    return failures ? 1 : 0;
+}
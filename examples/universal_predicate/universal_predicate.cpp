@@ -0,0 +1,93 @@
+/*
+ELEKTRON © 2026 - now
+Written by melektron
+www.elektron.work
+16.10.26, 23:10
+All rights reserved.
+
+This source code is licensed under the Apache-2.0 license found in the
+LICENSE file in the root directory of this source tree. 
+
+Example usage of universal_predicate (sort of a test-like code).
+The program exits with a non-zero status if any check fails.
+*/
+
+#include <el/universal_predicate.hpp>
+#include <cstdio>
+#include <string>
+
+static int failures = 0;
+
+#define CHECK(cond) \
+    if (!(cond)) { std::printf("FAIL %s:%d: %s\r\n", __FILE__, __LINE__, #cond); failures++; } \
+    else std::printf("ok   %s\r\n", #cond)
+
+
+int main()
+{
+    std::printf("\r\n== compile and evaluate\r\n");
+    el::universal_predicate warm("value > 30 and unit == 'C'");
+    CHECK(warm.valid());
+    el::universal v = 35;
+    v.set_unit("C");
+    CHECK(warm(v));
+    v.set_unit("F");
+    CHECK(!warm(v));
+    v = 12;
+    v.set_unit("C");
+    CHECK(!warm(v));
+
+    std::printf("\r\n== same semantics as the universal operators\r\n");
+    el::universal_predicate eq("value == 1.5 or value == 'text' or value == #ff0000");
+    CHECK(eq(el::universal(1.5)));
+    CHECK(eq(el::universal("text")));
+    CHECK(eq(el::universal(el::types::rgb24_t(0xff0000))));
+    CHECK(!eq(el::universal()));
+    el::universal_predicate le("value <= 10");
+    CHECK(le(el::universal(10)) == !(el::universal(10) > el::universal(10)));
+    CHECK(!le(el::universal(11)));
+
+    std::printf("\r\n== constant folding\r\n");
+    el::universal_predicate folded("not (1 < 2) or value == 3");
+    CHECK(folded.valid());
+    CHECK(folded.instruction_count() == 1);
+    CHECK(folded(el::universal(3)));
+
+    std::printf("\r\n== batch evaluation\r\n");
+    el::universal values[] = {1, 5, 10, 20, 40};
+    bool results[5];
+    el::universal_predicate range("value >= 5 and value < 20");
+    CHECK(range.evaluate(values, 5, results) == 2);
+    CHECK(!results[0] && results[1] && results[2] && !results[3] && !results[4]);
+
+    std::printf("\r\n== syntax errors\r\n");
+    el::universal_predicate broken;
+    CHECK(broken.compile("value >") == el::retcode::invalid);
+    CHECK(!broken.valid());
+    CHECK(!broken.error().empty());
+    CHECK(!broken(el::universal(1)));
+    CHECK(broken.compile("(value == 1") == el::retcode::invalid);
+    CHECK(broken.compile("value == 1 )") == el::retcode::invalid);
+    CHECK(broken.compile("value == 'open") == el::retcode::invalid);
+
+    std::printf("\r\n== default constructed predicate matches nothing\r\n");
+    el::universal_predicate nothing;
+    CHECK(!nothing(el::universal(1)));
+    CHECK(nothing.evaluate(values, 5, results) == 0);
+
+    std::printf("\r\n== deeply nested input is rejected, not a crash\r\n");
+    std::string deep = std::string(200000, '(') + "true" + std::string(200000, ')');
+    CHECK(broken.compile(deep) == el::retcode::invalid);
+    std::string nots;
+    for (int i = 0; i < 200000; i++)
+        nots += "not ";
+    CHECK(broken.compile(nots + "true") == el::retcode::invalid);
+    std::string chain = "true";
+    for (int i = 0; i < 200000; i++)
+        chain += " and true";
+    CHECK(broken.compile(chain) == el::retcode::invalid);
+    CHECK(broken.compile("((((((((value == 1))))))))") == el::retcode::ok);
+
+    std::printf("\r\n%d check(s) failed\r\n", failures);
+    return failures == 0 ? 0 : 1;
+}
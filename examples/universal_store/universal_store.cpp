@@ -0,0 +1,127 @@
+/*
+ELEKTRON © 2026 - now
+Written by melektron
+www.elektron.work
+16.10.26, 23:40
+All rights reserved.
+
+This source code is licensed under the Apache-2.0 license found in the
+LICENSE file in the root directory of this source tree. 
+
+Example usage of universal_store (sort of a test-like code).
+The program exits with a non-zero status if any check fails.
+*/
+
+#include <el/universal_store.hpp>
+#include <cstdio>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static int failures = 0;
+
+#define CHECK(cond) \
+    if (!(cond)) { std::printf("FAIL %s:%d: %s\r\n", __FILE__, __LINE__, #cond); failures++; } \
+    else std::printf("ok   %s\r\n", #cond)
+
+static bool file_exists(const std::string &_path)
+{
+    struct stat st;
+    return stat(_path.c_str(), &st) == 0;
+}
+
+
+int main()
+{
+    const std::string path = "./example_store.bin";
+    const std::string tmp_path = path + ".tmp";
+    std::remove(path.c_str());
+
+    std::printf("\r\n== create and write\r\n");
+    {
+        el::universal_store store;
+        CHECK(store.open(path, 16, 64) == el::retcode::ok);
+        el::universal temperature = 21.5;
+        temperature.set_timestamp(1234);
+        CHECK(store.set("temperature", temperature) == el::retcode::ok);
+        CHECK(store.set("on", el::universal(true)) == el::retcode::ok);
+        CHECK(store.set("color", el::universal(el::types::rgb24_t(0x123456))) == el::retcode::ok);
+        CHECK(store.set("count", el::universal(42)) == el::retcode::ok);
+        CHECK(store.set("nothing", el::universal()) == el::retcode::ok);
+        // strings larger than the initial log grow the file
+        CHECK(store.set("name", el::universal(std::string(500, 'n'))) == el::retcode::ok);
+        for (int i = 0; i < 100; i++)
+            store.set("status", el::universal("status " + std::to_string(i)));
+        CHECK(store.size() == 7);
+    }
+
+    std::printf("\r\n== reopen and read back\r\n");
+    {
+        el::universal_store store;
+        CHECK(store.open(path) == el::retcode::ok);
+        el::universal v;
+        CHECK(store.get("temperature", v) && v == 21.5 && v.get_timestamp() == 1234);
+        CHECK(store.get("on", v) && v == true);
+        CHECK(store.get("color", v) && v.to_rgb24_t().to_packed() == 0x123456);
+        CHECK(store.get("count", v) && v == 42);
+        CHECK(store.get("nothing", v) && v.get_type() == el::universal_type_t::empty);
+        CHECK(store.get("name", v) && v.get_string() == std::string(500, 'n'));
+        CHECK(store.get("status", v) && v == "status 99");
+        CHECK(!store.get("missing", v));
+
+        std::printf("\r\n== compaction\r\n");
+        size_t before = store.log_used();
+        CHECK(store.compact() == el::retcode::ok);
+        CHECK(store.log_used() < before);
+        CHECK(store.log_used() == store.log_live());
+        CHECK(!file_exists(tmp_path));
+        CHECK(store.get("status", v) && v == "status 99");
+
+        std::printf("\r\n== compaction failure keeps the store usable\r\n");
+        // a directory in place of the temporary file makes compaction fail
+        mkdir(tmp_path.c_str(), 0755);
+        CHECK(store.compact() != el::retcode::ok);
+        rmdir(tmp_path.c_str());
+        CHECK(store.get("count", v) && v == 42);
+
+        std::printf("\r\n== limits\r\n");
+        CHECK(store.set(std::string(el::universal_store::max_name_length + 1, 'x'), el::universal(1)) == el::retcode::e_size);
+        el::retcode r;
+        int i = 0;
+        do
+        {
+            r = store.set("key" + std::to_string(i), el::universal(i));
+            i++;
+        } while (r == el::retcode::ok);
+        CHECK(r == el::retcode::e_size);
+        CHECK(store.size() == 16);
+    }
+
+    std::printf("\r\n== invalid files and arguments\r\n");
+    {
+        FILE *f = std::fopen(path.c_str(), "r+");
+        std::fputc('X', f);
+        std::fclose(f);
+        el::universal_store store;
+        CHECK(store.open(path) == el::retcode::invalid);
+        CHECK(!store.is_open());
+        CHECK(store.set("a", el::universal(1)) == el::retcode::invalid);
+
+        std::remove(path.c_str());
+        CHECK(store.open(path, 0x80000001u) == el::retcode::e_size);
+        CHECK(!file_exists(path));
+    }
+
+    std::printf("\r\n== durable mode\r\n");
+    {
+        el::universal_store store;
+        CHECK(store.open(path, 16, 8, true) == el::retcode::ok);
+        CHECK(store.set("a", el::universal(std::string(5000, 'z'))) == el::retcode::ok);
+        el::universal v;
+        CHECK(store.get("a", v) && v.get_string().size() == 5000);
+    }
+    std::remove(path.c_str());
+
+    std::printf("\r\n%d check(s) failed\r\n", failures);
+    return failures == 0 ? 0 : 1;
+}
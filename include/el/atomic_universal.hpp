@@ -0,0 +1,378 @@
+/*
+ELEKTRON © 2026 - now
+Written by melektron
+www.elektron.work
+16.10.26, 14:15
+All rights reserved.
+
+This source code is licensed under the Apache-2.0 license found in the
+LICENSE file in the root directory of this source tree.
+
+Seqlock protected container for sharing an el::universal value between
+threads where readers never block the writer and never see a torn value.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <cstring>
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include "cxxversions.h"
+#ifdef __EL_ENABLE_CXX17
+
+#include "universal.hpp"
+#include "types.hpp"
+
+// not every C++20 standard library provides std::atomic<std::shared_ptr> (e.g. libc++)
+#if defined(__cpp_lib_atomic_shared_ptr) && __cpp_lib_atomic_shared_ptr >= 201711L
+#define __EL_ATOMIC_UNIVERSAL_ATOMIC_SHARED_PTR
+#endif
+
+namespace el
+{
+    /**
+     * @brief Thread-safe container of a single universal value.
+     *
+     * Numeric values (integer, floating, boolean, rgb24) and the timestamp are
+     * stored in place and protected by a sequence lock: Readers copy the value
+     * and retry if a write happened concurrently, so they never block and never
+     * observe a partially written value.
+     * Strings and values with a unit are stored as an immutable heap copy which is
+     * published by atomically swapping a shared pointer (RCU-style). Readers keep the
+     * copy alive while they read it, so it is freed once the last reader is done.
+     *
+     * Writers serialize among each other using the sequence counter. The container
+     * is designed for a single or few writers and many readers.
+     */
+    class atomic_universal
+    {
+    public:
+        using type_t = universal::type_t;
+
+    protected:
+        // type tag value marking that the value is stored in the shared pointer
+        static constexpr uint8_t indirect_type = 0xFF;
+
+        using indirect_ptr_t = std::shared_ptr<const universal>;
+
+        // sequence counter, odd while a write is in progress
+        std::atomic<uint32_t> sequence{0};
+        std::atomic<uint8_t> type{(uint8_t)type_t::empty};
+        std::atomic<uint64_t> payload{0};
+        std::atomic<uint64_t> timestamp{0};
+#ifdef __EL_ATOMIC_UNIVERSAL_ATOMIC_SHARED_PTR
+        std::atomic<indirect_ptr_t> indirect;
+#else
+        indirect_ptr_t indirect;    // only accessed with std::atomic_load/store
+#endif
+
+        indirect_ptr_t load_indirect() const noexcept
+        {
+#ifdef __EL_ATOMIC_UNIVERSAL_ATOMIC_SHARED_PTR
+            return indirect.load(std::memory_order_acquire);
+#else
+            return std::atomic_load_explicit(&indirect, std::memory_order_acquire);
+#endif
+        }
+
+        void store_indirect(indirect_ptr_t _ptr) noexcept
+        {
+#ifdef __EL_ATOMIC_UNIVERSAL_ATOMIC_SHARED_PTR
+            indirect.store(std::move(_ptr), std::memory_order_release);
+#else
+            std::atomic_store_explicit(&indirect, std::move(_ptr), std::memory_order_release);
+#endif
+        }
+
+        /**
+         * @brief packs the value of a numeric universal into 8 bytes
+         */
+        static uint64_t pack(const universal &_value) noexcept
+        {
+            switch (_value.get_type())
+            {
+            case type_t::integer:
+                return (uint64_t)_value.to_int64_t();
+
+            case type_t::floating:
+            {
+                double d = _value.to_double();
+                uint64_t bits;
+                std::memcpy(&bits, &d, sizeof(bits));
+                return bits;
+            }
+
+            case type_t::boolean:
+                return _value.to_bool();
+
+            case type_t::rgb24:
+                return _value.to_rgb24_t().to_packed();
+
+            default:
+                return 0;
+            }
+        }
+
+        /**
+         * @brief creates a universal object from packed numeric data
+         */
+        static universal unpack(uint8_t _type, uint64_t _payload, uint64_t _timestamp)
+        {
+            universal value;
+            switch ((type_t)_type)
+            {
+            case type_t::integer:
+                value = (int64_t)_payload;
+                break;
+
+            case type_t::floating:
+            {
+                double d;
+                std::memcpy(&d, &_payload, sizeof(d));
+                value = d;
+                break;
+            }
+
+            case type_t::boolean:
+                value = _payload != 0;
+                break;
+
+            case type_t::rgb24:
+                value = types::rgb24_t((uint32_t)_payload);
+                break;
+
+            default:
+                break;
+            }
+            value.set_timestamp(_timestamp);
+            return value;
+        }
+
+        /**
+         * @return true if the value needs to be stored in the shared pointer
+         */
+        static bool needs_indirect(const universal &_value) noexcept
+        {
+            return _value.get_type() == type_t::string || !_value.get_unit().empty();
+        }
+
+        /**
+         * @brief waits until no other writer is active and marks a write as in progress.
+         * @return the (odd) sequence value during the write
+         */
+        uint32_t lock_write() noexcept
+        {
+            uint32_t s = sequence.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                if (!(s & 1) && sequence.compare_exchange_weak(s, s + 1, std::memory_order_acquire, std::memory_order_relaxed))
+                    break;
+                std::this_thread::yield();
+                s = sequence.load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_release);
+            return s + 1;
+        }
+
+        void unlock_write(uint32_t _s) noexcept
+        {
+            sequence.store(_s + 1, std::memory_order_release);
+        }
+
+        /**
+         * @brief creates the heap copy of _value if it can't be stored inline.
+         * This may throw and must therefore be done before taking the write lock.
+         */
+        static indirect_ptr_t prepare_indirect(const universal &_value)
+        {
+            if (needs_indirect(_value))
+                return std::make_shared<const universal>(_value);
+            return nullptr;
+        }
+
+        /**
+         * @brief writes a value. Must be called with the write lock held.
+         * _indirect must be the result of prepare_indirect(_value), so
+         * nothing in the critical section can throw.
+         */
+        void write_locked(const universal &_value, indirect_ptr_t _indirect) noexcept
+        {
+            if (_indirect != nullptr)
+            {
+                store_indirect(std::move(_indirect));
+                type.store(indirect_type, std::memory_order_relaxed);
+            }
+            else
+            {
+                type.store((uint8_t)_value.get_type(), std::memory_order_relaxed);
+                payload.store(pack(_value), std::memory_order_relaxed);
+                timestamp.store(_value.get_timestamp(), std::memory_order_relaxed);
+                if (load_indirect() != nullptr)
+                    store_indirect(nullptr);
+            }
+        }
+
+        /**
+         * @brief reads a consistent snapshot of the stored data
+         */
+        void read_snapshot(uint8_t &_type, uint64_t &_payload, uint64_t &_timestamp, indirect_ptr_t &_indirect) const noexcept
+        {
+            for (;;)
+            {
+                uint32_t s1 = sequence.load(std::memory_order_acquire);
+                if (s1 & 1)
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+                _type = type.load(std::memory_order_relaxed);
+                _payload = payload.load(std::memory_order_relaxed);
+                _timestamp = timestamp.load(std::memory_order_relaxed);
+                if (_type == indirect_type)
+                    _indirect = load_indirect();
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (sequence.load(std::memory_order_relaxed) == s1)
+                    return;
+            }
+        }
+
+        /**
+         * @return true if the stored data represents exactly the same value as _value
+         * (same type, same value, unit and timestamp are ignored)
+         */
+        static bool same_value(uint8_t _type, uint64_t _payload, const indirect_ptr_t &_indirect, const universal &_value) noexcept
+        {
+            if (_type == indirect_type)
+            {
+                return _indirect->get_type() == _value.get_type()
+                    && (_value.get_type() != type_t::string || _indirect->get_string() == _value.get_string())
+                    && (_value.get_type() == type_t::string || pack(*_indirect) == pack(_value));
+            }
+            return _type == (uint8_t)_value.get_type() && _payload == pack(_value);
+        }
+
+    public:
+        atomic_universal() = default;
+
+        atomic_universal(const universal &_value)
+        {
+            store(_value);
+        }
+
+        // the container itself is not copyable, copy the loaded value instead
+        atomic_universal(const atomic_universal &) = delete;
+        atomic_universal &operator=(const atomic_universal &) = delete;
+
+        /**
+         * @brief reads the current value. Never blocks, but retries while a write is in progress.
+         *
+         * @return copy of the current value including the timestamp (and unit if it has one)
+         */
+        universal load() const
+        {
+            uint8_t t;
+            uint64_t p, ts;
+            indirect_ptr_t ptr;
+            read_snapshot(t, p, ts, ptr);
+            if (t == indirect_type)
+                return *ptr;
+            return unpack(t, p, ts);
+        }
+
+        /**
+         * @brief reads the current value converted to double without constructing
+         * a universal object for numeric values.
+         */
+        double load_double() const noexcept
+        {
+            uint8_t t;
+            uint64_t p, ts;
+            indirect_ptr_t ptr;
+            read_snapshot(t, p, ts, ptr);
+            switch (t)
+            {
+            case (uint8_t)type_t::integer:
+                return (int64_t)p;
+
+            case (uint8_t)type_t::floating:
+            {
+                double d;
+                std::memcpy(&d, &p, sizeof(d));
+                return d;
+            }
+
+            case (uint8_t)type_t::boolean:
+            case (uint8_t)type_t::rgb24:
+                return p;
+
+            case indirect_type:
+                return ptr->to_double();
+
+            default:
+                return 0;
+            }
+        }
+
+        /**
+         * @return the timestamp of the current value
+         */
+        uint64_t load_timestamp() const noexcept
+        {
+            uint8_t t;
+            uint64_t p, ts;
+            indirect_ptr_t ptr;
+            read_snapshot(t, p, ts, ptr);
+            if (t == indirect_type)
+                return ptr->get_timestamp();
+            return ts;
+        }
+
+        /**
+         * @brief replaces the current value with _value (including timestamp and unit).
+         */
+        void store(const universal &_value)
+        {
+            indirect_ptr_t indirect = prepare_indirect(_value);
+            uint32_t s = lock_write();
+            write_locked(_value, std::move(indirect));
+            unlock_write(s);
+        }
+
+        /**
+         * @brief replaces the current value with _desired if it currently holds exactly
+         * the same value as _expected (same type and value, unit and timestamp are not compared).
+         * Otherwise, _expected is set to the current value.
+         *
+         * @retval true the value was replaced
+         * @retval false the value was different and _expected has been updated
+         */
+        bool compare_exchange(universal &_expected, const universal &_desired)
+        {
+            indirect_ptr_t indirect = prepare_indirect(_desired);
+            uint32_t s = lock_write();
+
+            // no other writer can change the data while the lock is held
+            uint8_t t = type.load(std::memory_order_relaxed);
+            uint64_t p = payload.load(std::memory_order_relaxed);
+            uint64_t ts = timestamp.load(std::memory_order_relaxed);
+            indirect_ptr_t ptr;
+            if (t == indirect_type)
+                ptr = load_indirect();
+
+            bool matches = same_value(t, p, ptr, _expected);
+            if (matches)
+                write_locked(_desired, std::move(indirect));
+
+            unlock_write(s);
+
+            if (!matches)
+                _expected = (t == indirect_type) ? universal(*ptr) : unpack(t, p, ts);
+            return matches;
+        }
+    };
+};
+
+#endif  // __EL_ENABLE_CXX17
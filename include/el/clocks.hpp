@@ -0,0 +1,114 @@
+/*
+ELEKTRON © 2026 - now
+Written by melektron
+www.elektron.work
+16.10.26, 10:48
+All rights reserved.
+
+This source code is licensed under the Apache-2.0 license found in the
+LICENSE file in the root directory of this source tree.
+
+Cheap clock sources for timestamping data, e.g. as automatic
+timestamp source of el::universal.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <chrono>
+
+#if defined(__linux__)
+#include <time.h>
+#endif
+
+// MSVC doesn't define __x86_64__/__i386__ but _M_X64/_M_IX86
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace el::clocks
+{
+    /**
+     * @brief function pointer type of a clock source.
+     * Every clock source in this namespace (monotonic_coarse, cached_tick, tsc)
+     * satisfies this type.
+     */
+    using source_t = uint64_t (*)() noexcept;
+
+    /**
+     * @brief reads a coarse monotonic clock. On Linux this is CLOCK_MONOTONIC_COARSE
+     * which is served from the vDSO without a syscall and has a resolution
+     * of one scheduler tick (typically 1-4ms). On other platforms std::chrono::steady_clock
+     * is used as a fallback.
+     *
+     * @return uint64_t time in nanoseconds since an unspecified point in the past
+     */
+    inline uint64_t monotonic_coarse() noexcept
+    {
+#if defined(__linux__) && defined(CLOCK_MONOTONIC_COARSE)
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+        return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+#else
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()
+        ).count();
+#endif
+    }
+
+    // per-thread tick value that is returned by cached_tick()
+    inline thread_local uint64_t cached_tick_value = 0;
+
+    /**
+     * @brief sets the per-thread cached tick to a specific value.
+     * This is intended to be called once per iteration of a control or
+     * event loop with whatever time base the loop uses.
+     *
+     * @param _tick new tick value for the calling thread
+     */
+    inline void update_cached_tick(uint64_t _tick) noexcept
+    {
+        cached_tick_value = _tick;
+    }
+
+    /**
+     * @brief sets the per-thread cached tick to the current value of monotonic_coarse().
+     */
+    inline void update_cached_tick() noexcept
+    {
+        cached_tick_value = monotonic_coarse();
+    }
+
+    /**
+     * @brief reads the per-thread cached tick without accessing any clock.
+     * This is the cheapest source but only as accurate as the calls to update_cached_tick().
+     *
+     * @return uint64_t the value of the last update_cached_tick() call in the calling thread
+     */
+    inline uint64_t cached_tick() noexcept
+    {
+        return cached_tick_value;
+    }
+
+    /**
+     * @brief reads the CPU's time stamp counter (rdtsc on x86, cntvct_el0 on aarch64).
+     * The unit is CPU specific ticks and the counter is not necessarily synchronized
+     * between cores. On other architectures, this falls back to monotonic_coarse().
+     *
+     * @return uint64_t current counter value
+     */
+    inline uint64_t tsc() noexcept
+    {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+        return __rdtsc();
+#elif defined(__aarch64__)
+        uint64_t value;
+        asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+        return value;
+#else
+        return monotonic_coarse();
+#endif
+    }
+};
@@ -0,0 +1,578 @@
+/*
+ELEKTRON © 2026 - now
+Written by melektron
+www.elektron.work
+16.10.26, 13:31
+All rights reserved.
+
+This source code is licensed under the Apache-2.0 license found in the
+LICENSE file in the root directory of this source tree.
+
+compact_universal is an 8 byte, trivially copyable counterpart of el::universal
+using NaN-boxing. Doubles are stored as they are, all other types are stored
+in the payload bits of negative quiet NaNs:
+
+    1111 1111 1111 1ttt pppp ... pppp
+    ^ sign, exponent and quiet bit   ^ 48 bit payload, ttt = 3 bit tag
+
+Integers within 48 bit signed range, booleans and colors are stored inline.
+Strings and integers exceeding the inline range are stored in an external
+compact_table and referenced by index. The table interns its entries, so
+equal contents always get the same index.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <cstring>
+#include <string>
+#include <deque>
+#include <vector>
+#include <unordered_map>
+#include <type_traits>
+
+#include "cxxversions.h"
+#ifdef __EL_ENABLE_CXX17
+
+#include <string_view>
+
+#include "universal.hpp"
+#include "types.hpp"
+
+namespace el
+{
+    /**
+     * @brief external storage for the strings and wide integers referenced
+     * by compact_universal values. Entries are interned and never removed,
+     * so indices stay valid for the lifetime of the table.
+     */
+    class compact_table
+    {
+    protected:
+        // deque keeps the strings in place so the views in the index stay valid
+        std::deque<std::string> strings;
+        std::unordered_map<std::string_view, uint64_t> string_index;
+        std::vector<int64_t> integers;
+        std::unordered_map<int64_t, uint64_t> integer_index;
+
+    public:
+        compact_table() = default;
+        // the string index refers to the string storage, so the table can't be copied or moved
+        compact_table(const compact_table &) = delete;
+        compact_table &operator=(const compact_table &) = delete;
+
+        /**
+         * @return the index of a string with the contents _s, adding it if it doesn't exist yet
+         */
+        uint64_t intern_string(std::string_view _s)
+        {
+            auto it = string_index.find(_s);
+            if (it != string_index.end())
+                return it->second;
+            uint64_t index = strings.size();
+            strings.emplace_back(_s);
+            string_index.emplace(std::string_view(strings.back()), index);
+            return index;
+        }
+
+        /**
+         * @return the index of the integer _i, adding it if it doesn't exist yet
+         */
+        uint64_t intern_integer(int64_t _i)
+        {
+            auto it = integer_index.find(_i);
+            if (it != integer_index.end())
+                return it->second;
+            uint64_t index = integers.size();
+            integers.push_back(_i);
+            integer_index.emplace(_i, index);
+            return index;
+        }
+
+        /**
+         * @return the string with index _index
+         */
+        std::string_view get_string(uint64_t _index) const noexcept
+        {
+            return strings[_index];
+        }
+
+        /**
+         * @return the integer with index _index
+         */
+        int64_t get_integer(uint64_t _index) const noexcept
+        {
+            return integers[_index];
+        }
+
+        size_t string_count() const noexcept
+        {
+            return strings.size();
+        }
+
+        size_t integer_count() const noexcept
+        {
+            return integers.size();
+        }
+    };
+
+    /**
+     * @brief 8 byte NaN-boxed universal value. See compact_universal.hpp for the layout.
+     * Conversion and comparison functions follow the same rules as el::universal.
+     * Because strings and wide integers live in a compact_table, all functions that
+     * may need their contents take the table as an argument.
+     */
+    class compact_universal
+    {
+    public:
+        using type_t = universal::type_t;
+
+    protected:
+        static constexpr uint64_t box_mask = 0xFFF8000000000000ull;
+        static constexpr uint64_t payload_mask = 0x0000FFFFFFFFFFFFull;
+        static constexpr int tag_shift = 48;
+        static constexpr uint64_t canonical_nan = 0x7FF8000000000000ull;
+
+        enum tag_t : uint64_t
+        {
+            tag_empty = 0,
+            tag_integer = 1,
+            tag_boolean = 2,
+            tag_rgb24 = 3,
+            tag_string = 4,
+            tag_wide_integer = 5,
+        };
+
+        uint64_t bits = box_mask | ((uint64_t)tag_empty << tag_shift);
+
+        static constexpr uint64_t box(tag_t _tag, uint64_t _payload) noexcept
+        {
+            return box_mask | ((uint64_t)_tag << tag_shift) | (_payload & payload_mask);
+        }
+
+        bool is_boxed() const noexcept
+        {
+            return (bits & box_mask) == box_mask;
+        }
+
+        tag_t tag() const noexcept
+        {
+            return (tag_t)((bits >> tag_shift) & 0x7);
+        }
+
+        uint64_t payload() const noexcept
+        {
+            return bits & payload_mask;
+        }
+
+        /**
+         * @brief all value representations of a compact_universal
+         * decoded with help of the table, used to apply universal's rules.
+         */
+        struct unpacked_t
+        {
+            type_t type = type_t::empty;
+            int64_t integer = 0;
+            double floating = 0;
+            bool boolean = false;
+            types::rgb24_t rgb24;
+            std::string_view string;
+        };
+
+        unpacked_t unpack(const compact_table &_table) const noexcept
+        {
+            unpacked_t u;
+            u.type = get_type();
+            switch (u.type)
+            {
+            case type_t::integer:
+                u.integer = to_int64_t(_table);
+                break;
+
+            case type_t::floating:
+                std::memcpy(&u.floating, &bits, sizeof(double));
+                break;
+
+            case type_t::boolean:
+                u.boolean = payload() != 0;
+                break;
+
+            case type_t::rgb24:
+                u.rgb24 = types::rgb24_t((uint32_t)payload());
+                break;
+
+            case type_t::string:
+                u.string = _table.get_string(payload());
+                break;
+
+            default:
+                break;
+            }
+            return u;
+        }
+
+    public:
+        // smallest and largest integer that can be stored inline
+        static constexpr int64_t inline_min = -((int64_t)1 << 47);
+        static constexpr int64_t inline_max = ((int64_t)1 << 47) - 1;
+
+        // empty value
+        compact_universal() = default;
+
+        // integer literal initialization (always fits inline)
+        compact_universal(int _d) noexcept
+            : bits(box(tag_integer, (uint64_t)(int64_t)_d))
+        {}
+        // floating point initialization. NaN values are stored as a canonical quiet NaN.
+        compact_universal(double _d) noexcept
+        {
+            if (_d != _d)
+                bits = canonical_nan;
+            else
+                std::memcpy(&bits, &_d, sizeof(bits));
+        }
+        // boolean initialization
+        compact_universal(bool _d) noexcept
+            : bits(box(tag_boolean, _d))
+        {}
+        // 24 bit RGB color initialization
+        compact_universal(const types::rgb24_t &_d) noexcept
+            : bits(box(tag_rgb24, _d.to_packed()))
+        {}
+        // integer initialization, integers outside the inline range are stored in the table
+        compact_universal(int64_t _d, compact_table &_table)
+        {
+            if (_d >= inline_min && _d <= inline_max)
+                bits = box(tag_integer, (uint64_t)_d);
+            else
+                bits = box(tag_wide_integer, _table.intern_integer(_d));
+        }
+        // string initialization, the string is stored in the table
+        compact_universal(std::string_view _d, compact_table &_table)
+            : bits(box(tag_string, _table.intern_string(_d)))
+        {}
+
+        /**
+         * @brief lossless conversion from universal. Unit and timestamp are not stored.
+         */
+        static compact_universal from_universal(const universal &_value, compact_table &_table)
+        {
+            switch (_value.get_type())
+            {
+            case type_t::string:
+                return compact_universal(std::string_view(_value.get_string()), _table);
+
+            case type_t::integer:
+                return compact_universal(_value.to_int64_t(), _table);
+
+            case type_t::floating:
+                return compact_universal(_value.to_double());
+
+            case type_t::boolean:
+                return compact_universal(_value.to_bool());
+
+            case type_t::rgb24:
+                return compact_universal(_value.to_rgb24_t());
+
+            case type_t::empty:
+            default:
+                return compact_universal();
+            }
+        }
+
+        /**
+         * @brief lossless conversion to universal
+         */
+        universal to_universal(const compact_table &_table) const
+        {
+            unpacked_t u = unpack(_table);
+            switch (u.type)
+            {
+            case type_t::string:
+                return universal(std::string(u.string));
+
+            case type_t::integer:
+                return universal(u.integer);
+
+            case type_t::floating:
+                return universal(u.floating);
+
+            case type_t::boolean:
+                return universal(u.boolean);
+
+            case type_t::rgb24:
+                return universal(u.rgb24);
+
+            case type_t::empty:
+            default:
+                return universal();
+            }
+        }
+
+        /**
+         * @return the raw 64 bit representation
+         */
+        uint64_t get_bits() const noexcept
+        {
+            return bits;
+        }
+
+        /**
+         * @brief creates a value from its raw 64 bit representation (as returned by get_bits())
+         */
+        static compact_universal from_bits(uint64_t _bits) noexcept
+        {
+            compact_universal v;
+            v.bits = _bits;
+            return v;
+        }
+
+        type_t get_type() const noexcept
+        {
+            if (!is_boxed())
+                return type_t::floating;
+            switch (tag())
+            {
+            case tag_integer:
+            case tag_wide_integer:
+                return type_t::integer;
+            case tag_boolean:
+                return type_t::boolean;
+            case tag_rgb24:
+                return type_t::rgb24;
+            case tag_string:
+                return type_t::string;
+            case tag_empty:
+            default:
+                return type_t::empty;
+            }
+        }
+
+        /**
+         * @return index of the string in the table if the type is string
+         */
+        uint64_t get_string_index() const noexcept
+        {
+            return payload();
+        }
+
+        // == type conversions (same rules as universal) == //
+
+        std::string to_string(const compact_table &_table) const
+        {
+            return to_universal(_table).to_string();
+        }
+
+        int64_t to_int64_t(const compact_table &_table) const noexcept
+        {
+            if (!is_boxed())
+            {
+                double d;
+                std::memcpy(&d, &bits, sizeof(d));
+                return d;
+            }
+            switch (tag())
+            {
+            case tag_integer:
+                // sign extend the 48 bit payload
+                return (int64_t)(payload() << 16) >> 16;
+            case tag_wide_integer:
+                return _table.get_integer(payload());
+            case tag_boolean:
+            case tag_rgb24:
+                return payload();
+            case tag_string:
+                return _table.get_string(payload()).length();
+            case tag_empty:
+            default:
+                return 0;
+            }
+        }
+
+        int to_int(const compact_table &_table) const noexcept
+        {
+            return to_int64_t(_table);
+        }
+
+        double to_double(const compact_table &_table) const noexcept
+        {
+            if (!is_boxed())
+            {
+                double d;
+                std::memcpy(&d, &bits, sizeof(d));
+                return d;
+            }
+            if (tag() == tag_string)
+                return _table.get_string(payload()).length();
+            return to_int64_t(_table);
+        }
+
+        types::rgb24_t to_rgb24_t(const compact_table &_table) const noexcept
+        {
+            unpacked_t u = unpack(_table);
+            switch (u.type)
+            {
+            case type_t::integer:
+                return types::rgb24_t(u.integer);
+            case type_t::floating:
+                return types::rgb24_t(u.floating);
+            case type_t::boolean:
+                return types::rgb24_t(u.boolean ? 0xffffff : 0);
+            case type_t::rgb24:
+                return u.rgb24;
+            default:
+                return types::rgb24_t();
+            }
+        }
+
+        bool to_bool(const compact_table &_table) const noexcept
+        {
+            if (!is_boxed())
+            {
+                double d;
+                std::memcpy(&d, &bits, sizeof(d));
+                return d;
+            }
+            return to_int64_t(_table) != 0;
+        }
+
+        // == comparisons (same rules as universal's operators) == //
+
+        /**
+         * @brief equivalent of universal's operator==
+         */
+        static bool equal(const compact_universal &_lhs, const compact_universal &_rhs, const compact_table &_table) noexcept
+        {
+            // identical bits are equal except for NaN
+            if (_lhs.bits == _rhs.bits)
+                return _lhs.bits != canonical_nan;
+
+            unpacked_t l = _lhs.unpack(_table);
+            unpacked_t r = _rhs.unpack(_table);
+            switch (r.type)
+            {
+            case type_t::string:
+                return l.type == type_t::string && l.string == r.string;
+
+            case type_t::integer:
+                switch (l.type)
+                {
+                case type_t::integer: return l.integer == r.integer;
+                case type_t::floating: return l.floating == (double)r.integer;
+                case type_t::boolean: return l.boolean == (bool)r.integer;
+                case type_t::rgb24: return l.rgb24 == (types::rgb24_t)r.integer;
+                default: return false;
+                }
+
+            case type_t::floating:
+                switch (l.type)
+                {
+                case type_t::integer: return (double)l.integer == r.floating;
+                case type_t::floating: return l.floating == r.floating;
+                case type_t::boolean: return l.boolean == (bool)r.floating;
+                case type_t::rgb24: return l.rgb24 == (types::rgb24_t)r.floating;
+                default: return false;
+                }
+
+            case type_t::boolean:
+                switch (l.type)
+                {
+                case type_t::integer: return l.integer == (int64_t)r.boolean;
+                case type_t::floating: return l.floating == (double)r.boolean;
+                case type_t::boolean: return l.boolean == r.boolean;
+                case type_t::rgb24: return l.rgb24 == (types::rgb24_t)(r.boolean ? 0xffffff : 0x0);
+                default: return false;
+                }
+
+            case type_t::rgb24:
+                switch (l.type)
+                {
+                case type_t::integer: return (types::rgb24_t)l.integer == r.rgb24;
+                case type_t::floating: return (types::rgb24_t)l.floating == r.rgb24;
+                case type_t::boolean: return (types::rgb24_t)(l.boolean ? 0xffffff : 0x0) == r.rgb24;
+                case type_t::rgb24: return l.rgb24 == r.rgb24;
+                default: return false;
+                }
+
+            case type_t::empty:
+                return l.type == type_t::empty;
+
+            default:
+                return false;
+            }
+        }
+
+        /**
+         * @brief equivalent of universal's operator<
+         */
+        static bool less(const compact_universal &_lhs, const compact_universal &_rhs, const compact_table &_table) noexcept
+        {
+            unpacked_t l = _lhs.unpack(_table);
+            unpacked_t r = _rhs.unpack(_table);
+
+            switch (r.type)
+            {
+            case type_t::string:
+                // strings compare by length like integers
+                r.type = type_t::integer;
+                r.integer = (int64_t)r.string.length();
+                [[fallthrough]];
+
+            case type_t::integer:
+                switch (l.type)
+                {
+                case type_t::integer: return l.integer < r.integer;
+                case type_t::floating: return l.floating < r.integer;
+                case type_t::boolean: return l.boolean < r.integer;
+                case type_t::rgb24: return l.rgb24.get_brightness() < r.integer;
+                case type_t::string: return l.string.length() < (size_t)r.integer;
+                default: return false;
+                }
+
+            case type_t::floating:
+                switch (l.type)
+                {
+                case type_t::integer: return l.integer < r.floating;
+                case type_t::floating: return l.floating < r.floating;
+                case type_t::boolean: return l.boolean < r.floating;
+                case type_t::rgb24: return l.rgb24.get_brightness() < r.floating;
+                case type_t::string: return l.string.length() < r.floating;
+                default: return false;
+                }
+
+            case type_t::boolean:
+                switch (l.type)
+                {
+                case type_t::integer: return l.integer < r.boolean;
+                case type_t::floating: return l.floating < r.boolean;
+                case type_t::boolean: return l.boolean < r.boolean;
+                case type_t::rgb24: return l.rgb24.get_brightness() < r.boolean;
+                case type_t::string: return l.string.length() < (size_t)r.boolean;
+                default: return false;
+                }
+
+            case type_t::rgb24:
+                switch (l.type)
+                {
+                case type_t::integer: return l.integer < r.rgb24.get_brightness();
+                case type_t::floating: return l.floating < r.rgb24.get_brightness();
+                case type_t::boolean: return l.boolean < r.rgb24.get_brightness();
+                case type_t::rgb24: return l.rgb24.get_brightness() < r.rgb24.get_brightness();
+                case type_t::string: return l.string.length() < (size_t)r.rgb24.get_brightness();
+                default: return false;
+                }
+
+            case type_t::empty:
+                return l.type == type_t::empty;
+
+            default:
+                return false;
+            }
+        }
+    };
+
+    static_assert(sizeof(compact_universal) == 8, "compact_universal must be 8 bytes");
+    static_assert(std::is_trivially_copyable_v<compact_universal>, "compact_universal must be trivially copyable");
+};
+
+#endif  // __EL_ENABLE_CXX17
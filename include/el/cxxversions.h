@@ -15,6 +15,7 @@ Currentyl this might not work for all compilers and it might not work at all.
 In order to bypass all version checking, just 
 #define __EL_ENABLE_CXX11
 #define __EL_ENABLE_CXX17
+#define __EL_ENABLE_CXX20
 to enable library features for versions not detected using the __cplusplus definition.
 */
 
@@ -44,6 +45,14 @@ to enable library features for versions not detected using the __cplusplus defin
 
 #endif
 
+// check for C++ 20 compatability
+#if __cplusplus >= 202002L
+
+#define __EL_CXX20
+#define __EL_ENABLE_CXX20
+
+#endif
+
 
 #if (defined(__cpp_exceptions) && __cpp_exceptions == 199711L) || (defined(__EXCEPTIONS) && __EXCEPTIONS == 1)
 // TODO: how to check this on MSVC?
@@ -0,0 +1,45 @@
+/*
+ELEKTRON © 2026 - now
+Written by melektron
+www.elektron.work
+17.10.26, 10:15
+All rights reserved.
+
+This source code is licensed under the Apache-2.0 license found in the
+LICENSE file in the root directory of this source tree.
+
+Internal bit manipulation helpers shared by the SIMD code paths of the library.
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace el::detail
+{
+    /**
+     * @return index of the lowest set bit of _mask, which must not be 0
+     */
+    inline unsigned lowest_bit(uint32_t _mask) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return (unsigned)__builtin_ctz(_mask);
+#elif defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index, _mask);
+        return (unsigned)index;
+#else
+        unsigned i = 0;
+        while (!(_mask & 1))
+        {
+            _mask >>= 1;
+            i++;
+        }
+        return i;
+#endif
+    }
+}
@@ -0,0 +1,147 @@
+/*
+ELEKTRON © 2026 - now
+Written by melektron
+www.elektron.work
+17.10.26, 10:20
+All rights reserved.
+
+This source code is licensed under the Apache-2.0 license found in the
+LICENSE file in the root directory of this source tree.
+
+Internal building blocks of the flat open addressing hash tables (universal_map,
+universal_dict): control bytes probed in groups of 16 (SSE2 if available).
+
+Every slot of a table has one control byte which is either empty, deleted or holds
+the lower 7 bits of the hash (h2) of the element in the slot. The upper bits (h1)
+select the first group to probe. Groups are probed triangularly, which visits every
+group once if the group count is a power of two.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <cstddef>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define __EL_GROUP_PROBE_SSE2
+#endif
+
+#include "bits.hpp"
+
+namespace el::detail
+{
+    static constexpr size_t group_width = 16;
+    static constexpr int8_t ctrl_empty = -128;  // 0b10000000
+    static constexpr int8_t ctrl_deleted = -2;  // 0b11111110
+
+    /**
+     * @brief group of 16 control bytes that can be matched at once
+     */
+    struct group_t
+    {
+        const int8_t *bytes;
+
+        /**
+         * @return bitmask of the bytes equal to _h2
+         */
+        uint32_t match(int8_t _h2) const noexcept
+        {
+#ifdef __EL_GROUP_PROBE_SSE2
+            __m128i g = _mm_loadu_si128((const __m128i *)bytes);
+            return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(_h2), g));
+#else
+            uint32_t mask = 0;
+            for (size_t i = 0; i < group_width; i++)
+                mask |= (uint32_t)(bytes[i] == _h2) << i;
+            return mask;
+#endif
+        }
+
+        /**
+         * @return bitmask of the empty slots
+         */
+        uint32_t match_empty() const noexcept
+        {
+            return match(ctrl_empty);
+        }
+
+        /**
+         * @return bitmask of the empty or deleted slots (all with the top bit set)
+         */
+        uint32_t match_free() const noexcept
+        {
+#ifdef __EL_GROUP_PROBE_SSE2
+            return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)bytes));
+#else
+            uint32_t mask = 0;
+            for (size_t i = 0; i < group_width; i++)
+                mask |= (uint32_t)(bytes[i] < 0) << i;
+            return mask;
+#endif
+        }
+    };
+
+    inline int8_t h2(size_t _hash) noexcept
+    {
+        return (int8_t)(_hash & 0x7F);
+    }
+
+    inline size_t h1(size_t _hash) noexcept
+    {
+        return _hash >> 7;
+    }
+
+    /**
+     * @brief searches the slot holding an element
+     *
+     * @param _ctrl control bytes
+     * @param _slot_count number of slots (power of two and multiple of group_width or 0)
+     * @param _hash hash of the element
+     * @param _matches called with the index of every slot whose control byte matches
+     * the hash, returns true if the slot holds the element
+     * @return index of the slot or _slot_count if not found
+     */
+    template<typename _Fn>
+    size_t find_slot(const int8_t *_ctrl, size_t _slot_count, size_t _hash, _Fn &&_matches)
+    {
+        if (_slot_count == 0)
+            return _slot_count;
+
+        size_t group_mask = _slot_count / group_width - 1;
+        size_t g = h1(_hash) & group_mask;
+        int8_t tag = h2(_hash);
+
+        for (size_t step = 1; ; step++)
+        {
+            group_t group{_ctrl + g * group_width};
+            for (uint32_t m = group.match(tag); m != 0; m &= m - 1)
+            {
+                size_t index = g * group_width + lowest_bit(m);
+                if (_matches(index))
+                    return index;
+            }
+            if (group.match_empty() != 0 || step > group_mask)
+                return _slot_count;
+            g = (g + step) & group_mask;
+        }
+    }
+
+    /**
+     * @brief finds the first empty or deleted slot in the probe sequence of a hash.
+     * The table must not be full.
+     */
+    inline size_t find_free_slot(const int8_t *_ctrl, size_t _slot_count, size_t _hash) noexcept
+    {
+        size_t group_mask = _slot_count / group_width - 1;
+        size_t g = h1(_hash) & group_mask;
+
+        for (size_t step = 1; ; step++)
+        {
+            uint32_t m = group_t{_ctrl + g * group_width}.match_free();
+            if (m != 0)
+                return g * group_width + lowest_bit(m);
+            g = (g + step) & group_mask;
+        }
+    }
+}
@@ -0,0 +1,268 @@
+/*
+ELEKTRON © 2026 - now
+Written by melektron
+www.elektron.work
+16.10.26, 21:05
+All rights reserved.
+
+This source code is licensed under the Apache-2.0 license found in the
+LICENSE file in the root directory of this source tree.
+
+Read-only memory mapped file. This is a zero-copy alternative to
+strutil::read_file_into_string() for files that are only scanned: the content
+is accessed directly through the page cache instead of being copied into a string.
+
+This header requires a POSIX platform (mmap).
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <cstddef>
+#include <string>
+
+#include "cxxversions.h"
+#ifdef __EL_ENABLE_CXX17
+
+#include <string_view>
+
+#ifdef __EL_ENABLE_CXX20
+#include <span>
+#endif
+
+#if __has_include(<sys/mman.h>) && __has_include(<unistd.h>)
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "retcode.hpp"
+
+namespace el
+{
+    /**
+     * @brief RAII wrapper of a read-only memory mapping of an entire file.
+     * The mapping is released when the object is destroyed or closed.
+     * The file descriptor is closed right after mapping, so an open
+     * mapped_file doesn't hold on to one.
+     *
+     * @note The contents must not be modified by other processes while mapped,
+     * and truncating the file while it is mapped makes accesses beyond the
+     * new end fault (SIGBUS).
+     */
+    class mapped_file
+    {
+    public:
+        /**
+         * @brief access pattern hints passed to the kernel with madvise()
+         */
+        enum class advice_t
+        {
+            normal,     // no special treatment (default)
+            sequential, // aggressive read-ahead, pages can be dropped after being read
+            random,     // no read-ahead
+            willneed,   // start reading the whole file into the page cache now
+            hugepage,   // back the mapping with transparent huge pages where supported
+        };
+
+    protected:
+        const char *map = nullptr;
+        size_t map_size = 0;
+        bool opened = false;
+
+    public:
+        mapped_file() = default;
+
+        mapped_file(const mapped_file &) = delete;
+        mapped_file &operator=(const mapped_file &) = delete;
+
+        mapped_file(mapped_file &&_other) noexcept
+            : map(_other.map)
+            , map_size(_other.map_size)
+            , opened(_other.opened)
+        {
+            _other.map = nullptr;
+            _other.map_size = 0;
+            _other.opened = false;
+        }
+
+        mapped_file &operator=(mapped_file &&_other) noexcept
+        {
+            if (this != &_other)
+            {
+                close();
+                map = _other.map;
+                map_size = _other.map_size;
+                opened = _other.opened;
+                _other.map = nullptr;
+                _other.map_size = 0;
+                _other.opened = false;
+            }
+            return *this;
+        }
+
+        ~mapped_file()
+        {
+            close();
+        }
+
+        /**
+         * @brief maps the entire file at _path read-only. A previously
+         * opened file is closed first. Empty files can be opened and
+         * result in an empty view.
+         *
+         * @param _path path of the file to map
+         * @param _advice initial access pattern hint (see advise())
+         * @retval retcode::ok the file is mapped
+         * @retval retcode::inv_path the file can't be opened or is not a regular file
+         * @retval retcode::err mapping the file failed
+         */
+        retcode open(const std::string &_path, advice_t _advice = advice_t::normal)
+        {
+            close();
+
+            int fd = ::open(_path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0)
+                return retcode::inv_path;
+
+            struct stat st;
+            if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+            {
+                ::close(fd);
+                return retcode::inv_path;
+            }
+
+            // mmap() rejects empty mappings
+            if (st.st_size > 0)
+            {
+                void *p = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+                if (p == MAP_FAILED)
+                {
+                    ::close(fd);
+                    return retcode::err;
+                }
+                map = (const char *)p;
+                map_size = (size_t)st.st_size;
+            }
+            ::close(fd);
+            opened = true;
+
+            if (_advice != advice_t::normal)
+                advise(_advice);
+            return retcode::ok;
+        }
+
+        /**
+         * @brief unmaps the file. Views obtained before become invalid.
+         */
+        void close() noexcept
+        {
+            if (map != nullptr)
+                munmap((void *)map, map_size);
+            map = nullptr;
+            map_size = 0;
+            opened = false;
+        }
+
+        bool is_open() const noexcept
+        {
+            return opened;
+        }
+
+        /**
+         * @brief passes an access pattern hint for the whole mapping to the kernel.
+         * Hints only affect performance, never the content.
+         *
+         * @param _advice the hint
+         * @retval retcode::ok the hint was accepted (or the file is empty)
+         * @retval retcode::invalid the file is not open
+         * @retval retcode::err the hint is not supported by the platform or kernel
+         */
+        retcode advise(advice_t _advice) noexcept
+        {
+            if (!opened)
+                return retcode::invalid;
+            if (map == nullptr)
+                return retcode::ok;
+
+            int flag;
+            switch (_advice)
+            {
+            case advice_t::normal:
+                flag = MADV_NORMAL;
+                break;
+            case advice_t::sequential:
+                flag = MADV_SEQUENTIAL;
+                break;
+            case advice_t::random:
+                flag = MADV_RANDOM;
+                break;
+            case advice_t::willneed:
+                flag = MADV_WILLNEED;
+                break;
+            case advice_t::hugepage:
+#ifdef MADV_HUGEPAGE
+                flag = MADV_HUGEPAGE;
+                break;
+#else
+                return retcode::err;
+#endif
+            default:
+                return retcode::err;
+            }
+            return madvise((void *)map, map_size, flag) == 0 ? retcode::ok : retcode::err;
+        }
+
+        /**
+         * @return size of the file in bytes
+         */
+        size_t size() const noexcept
+        {
+            return map_size;
+        }
+
+        bool empty() const noexcept
+        {
+            return map_size == 0;
+        }
+
+        /**
+         * @return pointer to the first character of the file or nullptr
+         * if it is empty or not open. The content is not null terminated.
+         */
+        const char *data() const noexcept
+        {
+            return map;
+        }
+
+        /**
+         * @return the file content as a string view
+         */
+        std::string_view view() const noexcept
+        {
+            return std::string_view(map, map_size);
+        }
+
+        operator std::string_view() const noexcept
+        {
+            return view();
+        }
+
+#ifdef __EL_ENABLE_CXX20
+
+        /**
+         * @return the file content as raw bytes
+         */
+        std::span<const std::byte> bytes() const noexcept
+        {
+            return std::span<const std::byte>((const std::byte *)map, map_size);
+        }
+
+#endif  // __EL_ENABLE_CXX20
+    };
+};
+
+#endif  // __has_include(<sys/mman.h>)
+
+#endif  // __EL_ENABLE_CXX17
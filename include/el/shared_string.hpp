@@ -0,0 +1,494 @@
+/*
+ELEKTRON © 2026 - now
+Written by melektron
+www.elektron.work
+16.10.26, 16:45
+All rights reserved.
+
+This source code is licensed under the Apache-2.0 license found in the
+LICENSE file in the root directory of this source tree.
+
+Immutable, reference counted string with copy-on-write semantics.
+Copies of heap allocated strings share the same buffer and only increment an
+atomic reference counter, short strings are stored inline. This makes copying
+a string O(1) and allocation-free, which is useful when the same value is
+distributed to many receivers (see el::shared_universal).
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <cstring>
+#include <cstddef>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <iostream>
+#include <functional>
+
+#include "cxxversions.h"
+#ifdef __EL_ENABLE_CXX17
+
+#include <string_view>
+
+namespace el
+{
+    /**
+     * @brief Reference counted string with copy-on-write and small string optimization.
+     *
+     * Strings of up to inline_capacity characters are stored inside the object.
+     * Longer strings are stored in a heap block together with an atomic reference
+     * counter. Copying the string shares the block. Any mutating operation first
+     * makes the block unique by copying it if it is shared (copy-on-write), so
+     * modifying one copy never affects the others.
+     *
+     * Like std::shared_ptr, different objects sharing the same block may be
+     * used from different threads concurrently, but a single object must not be
+     * modified and accessed at the same time from multiple threads.
+     *
+     * The interface is a subset of std::string large enough to be used as
+     * string type of el::basic_universal.
+     */
+    class shared_string
+    {
+    public:
+        using value_type = char;
+        using size_type = std::size_t;
+        using allocator_type = std::allocator<char>;
+
+        static constexpr size_type inline_capacity = 15;
+
+    protected:
+        // header of a heap block, followed by the characters and a null terminator
+        struct heap_t
+        {
+            std::atomic<uint32_t> refs;
+            size_type capacity;
+
+            char *chars() noexcept
+            {
+                return reinterpret_cast<char *>(this + 1);
+            }
+        };
+
+        using block_allocator_t = std::allocator<heap_t>;
+
+        heap_t *heap = nullptr;     // nullptr if the string is stored inline
+        size_type len = 0;
+        char inline_buffer[inline_capacity + 1] = {0};
+
+        // number of heap_t sized units needed for a block with capacity _cap
+        static size_type block_units(size_type _cap) noexcept
+        {
+            return (sizeof(heap_t) + _cap + 1 + sizeof(heap_t) - 1) / sizeof(heap_t);
+        }
+
+        static heap_t *allocate_block(size_type _cap)
+        {
+            block_allocator_t alloc;
+            heap_t *block = alloc.allocate(block_units(_cap));
+            new (&block->refs) std::atomic<uint32_t>(1);
+            block->capacity = _cap;
+            return block;
+        }
+
+        static void release_block(heap_t *_block) noexcept
+        {
+            if (_block == nullptr)
+                return;
+            if (_block->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                block_allocator_t alloc;
+                alloc.deallocate(_block, block_units(_block->capacity));
+            }
+        }
+
+        char *buffer() noexcept
+        {
+            return heap ? heap->chars() : inline_buffer;
+        }
+
+        /**
+         * @brief makes sure the string owns a buffer that is not shared and
+         * can hold at least _cap characters. The content is preserved.
+         */
+        void make_unique(size_type _cap)
+        {
+            if (heap == nullptr && _cap <= inline_capacity)
+                return;
+            if (heap != nullptr && heap->capacity >= _cap && heap->refs.load(std::memory_order_acquire) == 1)
+                return;
+
+            if (heap == nullptr || _cap > heap->capacity)
+            {
+                // grow exponentially to keep appending amortized O(1)
+                size_type old_cap = heap ? heap->capacity : inline_capacity;
+                if (_cap < old_cap * 2)
+                    _cap = old_cap * 2;
+            }
+            else
+            {
+                _cap = heap->capacity;
+            }
+
+            heap_t *block = allocate_block(_cap);
+            std::memcpy(block->chars(), buffer(), len);
+            block->chars()[len] = 0;
+            release_block(heap);
+            heap = block;
+        }
+
+        /**
+         * @brief replaces the content with _n characters from _s without reusing
+         * a shared block.
+         */
+        void assign_new(const char *_s, size_type _n)
+        {
+            heap_t *block = nullptr;
+            if (_n > inline_capacity)
+            {
+                if (heap != nullptr && heap->capacity >= _n && heap->refs.load(std::memory_order_acquire) == 1)
+                {
+                    // the block is not shared, overwrite it in place
+                    std::memmove(heap->chars(), _s, _n);
+                    heap->chars()[_n] = 0;
+                    len = _n;
+                    return;
+                }
+                block = allocate_block(_n);
+                std::memcpy(block->chars(), _s, _n);
+                block->chars()[_n] = 0;
+            }
+            else
+            {
+                // _s might point into the current heap block, so copy before releasing it
+                std::memmove(inline_buffer, _s, _n);
+                inline_buffer[_n] = 0;
+            }
+            release_block(heap);
+            heap = block;
+            len = _n;
+        }
+
+    public:
+        shared_string() noexcept = default;
+
+        explicit shared_string(const allocator_type &) noexcept
+        {}
+
+        shared_string(const char *_s, size_type _n, const allocator_type & = allocator_type())
+        {
+            assign_new(_s, _n);
+        }
+
+        shared_string(const char *_s, const allocator_type &_alloc = allocator_type())
+            : shared_string(_s, std::strlen(_s), _alloc)
+        {}
+
+        explicit shared_string(std::string_view _s, const allocator_type &_alloc = allocator_type())
+            : shared_string(_s.data(), _s.size(), _alloc)
+        {}
+
+        // shares the heap block of _other
+        shared_string(const shared_string &_other) noexcept
+            : heap(_other.heap)
+            , len(_other.len)
+        {
+            if (heap != nullptr)
+                heap->refs.fetch_add(1, std::memory_order_relaxed);
+            else
+                std::memcpy(inline_buffer, _other.inline_buffer, sizeof(inline_buffer));
+        }
+
+        shared_string(const shared_string &_other, const allocator_type &) noexcept
+            : shared_string(_other)
+        {}
+
+        shared_string(shared_string &&_other) noexcept
+            : heap(_other.heap)
+            , len(_other.len)
+        {
+            if (heap == nullptr)
+                std::memcpy(inline_buffer, _other.inline_buffer, sizeof(inline_buffer));
+            _other.heap = nullptr;
+            _other.len = 0;
+            _other.inline_buffer[0] = 0;
+        }
+
+        shared_string(shared_string &&_other, const allocator_type &) noexcept
+            : shared_string(std::move(_other))
+        {}
+
+        ~shared_string()
+        {
+            release_block(heap);
+        }
+
+        shared_string &operator=(const shared_string &_other) noexcept
+        {
+            if (this == &_other)
+                return *this;
+            if (_other.heap != nullptr)
+                _other.heap->refs.fetch_add(1, std::memory_order_relaxed);
+            release_block(heap);
+            heap = _other.heap;
+            len = _other.len;
+            if (heap == nullptr)
+                std::memcpy(inline_buffer, _other.inline_buffer, sizeof(inline_buffer));
+            return *this;
+        }
+
+        shared_string &operator=(shared_string &&_other) noexcept
+        {
+            if (this == &_other)
+                return *this;
+            release_block(heap);
+            heap = _other.heap;
+            len = _other.len;
+            if (heap == nullptr)
+                std::memcpy(inline_buffer, _other.inline_buffer, sizeof(inline_buffer));
+            _other.heap = nullptr;
+            _other.len = 0;
+            _other.inline_buffer[0] = 0;
+            return *this;
+        }
+
+        shared_string &operator=(std::string_view _s)
+        {
+            return assign(_s.data(), _s.size());
+        }
+
+        shared_string &operator=(const char *_s)
+        {
+            return assign(_s, std::strlen(_s));
+        }
+
+        shared_string &assign(const char *_s, size_type _n)
+        {
+            assign_new(_s, _n);
+            return *this;
+        }
+
+        shared_string &assign(std::string_view _s)
+        {
+            return assign(_s.data(), _s.size());
+        }
+
+        allocator_type get_allocator() const noexcept
+        {
+            return allocator_type();
+        }
+
+        // == access == //
+
+        const char *data() const noexcept
+        {
+            return heap ? heap->chars() : inline_buffer;
+        }
+
+        const char *c_str() const noexcept
+        {
+            return data();
+        }
+
+        /**
+         * @return writable pointer to the characters. If the buffer is shared,
+         * it is copied first.
+         */
+        char *data()
+        {
+            make_unique(len);
+            return buffer();
+        }
+
+        char operator[](size_type _i) const noexcept
+        {
+            return data()[_i];
+        }
+
+        /**
+         * @return writable reference to a character. If the buffer is shared,
+         * it is copied first.
+         */
+        char &operator[](size_type _i)
+        {
+            return data()[_i];
+        }
+
+        size_type size() const noexcept
+        {
+            return len;
+        }
+
+        size_type length() const noexcept
+        {
+            return len;
+        }
+
+        size_type capacity() const noexcept
+        {
+            return heap ? heap->capacity : inline_capacity;
+        }
+
+        bool empty() const noexcept
+        {
+            return len == 0;
+        }
+
+        /**
+         * @return number of strings sharing the buffer, 0 for inline strings
+         */
+        size_type use_count() const noexcept
+        {
+            return heap ? heap->refs.load(std::memory_order_relaxed) : 0;
+        }
+
+        operator std::string_view() const noexcept
+        {
+            return std::string_view(data(), len);
+        }
+
+        // == modification (copy-on-write) == //
+
+        /**
+         * @brief removes the content. The string is stored inline afterwards,
+         * so a heap block is released (or freed if it was the last reference).
+         */
+        void clear() noexcept
+        {
+            release_block(heap);
+            heap = nullptr;
+            len = 0;
+            inline_buffer[0] = 0;
+        }
+
+        void reserve(size_type _cap)
+        {
+            if (_cap > capacity())
+                make_unique(_cap);
+        }
+
+        /**
+         * @brief moves a string that is not shared into a smaller block or into
+         * the object if the buffer is larger than needed. Shared buffers are left
+         * as they are, since sharing saves more memory than shrinking.
+         */
+        void shrink_to_fit()
+        {
+            if (heap != nullptr && heap->capacity > len && heap->refs.load(std::memory_order_acquire) == 1)
+            {
+                // allocate and fill the new storage before touching the members,
+                // so the string is unchanged if the allocation throws
+                heap_t *old = heap;
+                if (len > inline_capacity)
+                {
+                    heap_t *block = allocate_block(len);
+                    std::memcpy(block->chars(), old->chars(), len + 1);
+                    heap = block;
+                }
+                else
+                {
+                    std::memcpy(inline_buffer, old->chars(), len + 1);
+                    heap = nullptr;
+                }
+                release_block(old);
+            }
+        }
+
+        shared_string &append(const char *_s, size_type _n)
+        {
+            // _s might point into our own buffer, which make_unique() can free
+            const char *b = buffer();
+            if (_s >= b && _s < b + len)
+            {
+                shared_string copy(_s, _n);
+                return append(copy.c_str(), _n);
+            }
+            make_unique(len + _n);
+            char *dst = buffer();
+            std::memcpy(dst + len, _s, _n);
+            len += _n;
+            dst[len] = 0;
+            return *this;
+        }
+
+        shared_string &append(std::string_view _s)
+        {
+            return append(_s.data(), _s.size());
+        }
+
+        shared_string &operator+=(std::string_view _s)
+        {
+            return append(_s);
+        }
+
+        shared_string &operator+=(const char *_s)
+        {
+            return append(_s, std::strlen(_s));
+        }
+
+        shared_string &operator+=(char _c)
+        {
+            push_back(_c);
+            return *this;
+        }
+
+        void push_back(char _c)
+        {
+            make_unique(len + 1);
+            char *b = buffer();
+            b[len++] = _c;
+            b[len] = 0;
+        }
+
+        void swap(shared_string &_other) noexcept
+        {
+            shared_string tmp(std::move(_other));
+            _other = std::move(*this);
+            *this = std::move(tmp);
+        }
+
+        // == comparison == //
+
+        friend bool operator==(const shared_string &_lhs, const shared_string &_rhs) noexcept
+        {
+            // strings sharing a buffer are always equal
+            return (_lhs.heap != nullptr && _lhs.heap == _rhs.heap) || std::string_view(_lhs) == std::string_view(_rhs);
+        }
+        friend bool operator==(const shared_string &_lhs, std::string_view _rhs) noexcept { return std::string_view(_lhs) == _rhs; }
+        friend bool operator==(std::string_view _lhs, const shared_string &_rhs) noexcept { return _lhs == std::string_view(_rhs); }
+        friend bool operator==(const shared_string &_lhs, const char *_rhs) noexcept { return std::string_view(_lhs) == _rhs; }
+        friend bool operator==(const char *_lhs, const shared_string &_rhs) noexcept { return _lhs == std::string_view(_rhs); }
+
+        friend bool operator!=(const shared_string &_lhs, const shared_string &_rhs) noexcept { return !(_lhs == _rhs); }
+        friend bool operator!=(const shared_string &_lhs, std::string_view _rhs) noexcept { return !(_lhs == _rhs); }
+        friend bool operator!=(std::string_view _lhs, const shared_string &_rhs) noexcept { return !(_lhs == _rhs); }
+        friend bool operator!=(const shared_string &_lhs, const char *_rhs) noexcept { return !(_lhs == _rhs); }
+        friend bool operator!=(const char *_lhs, const shared_string &_rhs) noexcept { return !(_lhs == _rhs); }
+
+        friend bool operator<(const shared_string &_lhs, const shared_string &_rhs) noexcept { return std::string_view(_lhs) < std::string_view(_rhs); }
+        friend bool operator<(const shared_string &_lhs, std::string_view _rhs) noexcept { return std::string_view(_lhs) < _rhs; }
+        friend bool operator<(std::string_view _lhs, const shared_string &_rhs) noexcept { return _lhs < std::string_view(_rhs); }
+        friend bool operator<(const shared_string &_lhs, const char *_rhs) noexcept { return std::string_view(_lhs) < _rhs; }
+        friend bool operator<(const char *_lhs, const shared_string &_rhs) noexcept { return _lhs < std::string_view(_rhs); }
+        friend bool operator>(const shared_string &_lhs, const shared_string &_rhs) noexcept { return _rhs < _lhs; }
+        friend bool operator<=(const shared_string &_lhs, const shared_string &_rhs) noexcept { return !(_rhs < _lhs); }
+        friend bool operator>=(const shared_string &_lhs, const shared_string &_rhs) noexcept { return !(_lhs < _rhs); }
+
+        friend std::ostream &operator<<(std::ostream &_os, const shared_string &_s)
+        {
+            return _os << std::string_view(_s);
+        }
+    };
+};
+
+template<>
+struct std::hash<el::shared_string>
+{
+    std::size_t operator()(const el::shared_string &_s) const noexcept
+    {
+        return std::hash<std::string_view>()(std::string_view(_s));
+    }
+};
+
+#endif  // __EL_ENABLE_CXX17
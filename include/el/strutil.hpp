@@ -9,29 +9,108 @@ This source code is licensed under the Apache-2.0 license found in the
 LICENSE file in the root directory of this source tree. 
 
 Utility functions operating for strings, mostly STL compatible string types.
+The printf style formatting, lowercase/uppercase and read_file_into_string also
+work with C++11/14. The string_view based functions (case conversion, split, trim,
+join, line_reader, string_switch) require C++17, the {} format strings C++20.
 */
 
 #pragma once
 
 #include <stdio.h>
+#include <stdint.h>
 #include <string>
 #include <memory>
 #include <algorithm>
 #include <fstream>
 #include <cstring>
+#include <array>
+#include <iterator>
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+
+#include "cxxversions.h"
+
+#ifdef __EL_ENABLE_CXX17
+#include <charconv>
+#include <string_view>
+#include "detail/bits.hpp"
+#endif
+
+#ifdef __EL_ENABLE_CXX20
+#include <span>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define __EL_STRUTIL_SSE2
+#endif
 
 namespace el::strutil
 {
+    /**
+     * @brief formats a string like printf into a caller provided buffer using the
+     * system's snprintf function. The output is always null terminated and truncated
+     * if the buffer is too small.
+     * 
+     * @tparam _Args varadic format argument types
+     * @param _buffer output buffer
+     * @param _size size of the output buffer in bytes (including space for the null byte)
+     * @param _fmt Format string
+     * @param _args Format arguments
+     * @return size_t length of the complete formatted string (without null byte). If this is
+     * >= _size, the output was truncated.
+     */
+    template<typename... _Args>
+    size_t format_to(char *_buffer, size_t _size, const char *_fmt, _Args... _args)
+    {
+        int len = snprintf(_buffer, _size, _fmt, _args...);
+        return len < 0 ? 0 : (size_t)len;
+    }
+
+    /**
+     * @brief formats a string like printf and appends it to an existing string.
+     * Like format(), the output is formatted into a buffer on the stack first, so only
+     * results that are longer than 255 characters need a second pass (directly into
+     * the string's memory). The cost doesn't depend on the string's spare capacity.
+     * 
+     * @tparam _ST string type, typically std::string (can be deducted)
+     * @tparam _Args varadic format argument types
+     * @param _string The string to append to
+     * @param _fmt Format string
+     * @param _args Format arguments
+     * @return size_t number of characters appended
+     */
+    template<typename _ST, typename... _Args>
+    size_t format_append(_ST &_string, const char *_fmt, _Args... _args)
+    {
+        char buffer[256];
+        size_t len = format_to(buffer, sizeof(buffer), _fmt, _args...);
+        if (len < sizeof(buffer))
+        {
+            _string.append(buffer, len);
+            return len;
+        }
+
+        // didn't fit, format directly into the string (it always has room for the null byte)
+        size_t old_size = _string.size();
+        _string.resize(old_size + len);
+        format_to(&_string[old_size], len + 1, _fmt, _args...);
+        return len;
+    }
+
     /**
      * @brief creates a format string like printf or s(n)printf using the system's
      * snprintf function wrapped in a C++-like interface. 
      * Any STL compatible string type can be used as the format and return value type (see _ST).
-     * NOTE: This method uses dynamic memory allocation ("new" operator) and std::unique_ptr.
+     * The string is formatted into a buffer on the stack first, so only results that
+     * are longer than 255 characters need a second pass (directly into the result string).
      * Usually, the template arguments don't have to be provided but can be deducted from function
      * arguments.
      * 
      * @tparam _ST string type of the format and return value. The type must be constructable
-     * from "const char *" (string copy) and must have a .c_str() method to convert to "char *"".
+     * from "const char *" and a length, must be resizable and must have a .c_str() method to
+     * convert to "char *"".
      * @tparam _Args varadic format argument types
      * @param _fmt Format string
      * @param _args Format arguments
@@ -40,15 +119,404 @@ namespace el::strutil
     template<typename _ST, typename... _Args>
     _ST format(const _ST& _fmt, _Args... _args)
     {
-        size_t len = snprintf(nullptr, 0, _fmt.c_str(), _args...) + 1;  // extra space for null byte
-        std::unique_ptr<char[]> _cstr(new char[len]);
-        snprintf(_cstr.get(), len, _fmt.c_str(), _args...);
-        return _ST(_cstr.get());
+        char buffer[256];
+        size_t len = format_to(buffer, sizeof(buffer), _fmt.c_str(), _args...);
+        if (len < sizeof(buffer))
+            return _ST(buffer, len);
+
+        // didn't fit, format directly into the result
+        _ST result;
+        result.resize(len);
+        format_to(&result[0], len + 1, _fmt.c_str(), _args...);
+        return result;
+    }
+
+#ifdef __EL_ENABLE_CXX20
+
+    /**
+     * @brief string literal wrapper that can be passed as a template argument.
+     * This is used to hand format strings to the type-safe format functions
+     * so they can be parsed at compile time.
+     * 
+     * @tparam _N size of the literal including the null byte (deducted)
+     */
+    template<size_t _N>
+    struct fixed_string
+    {
+        char chars[_N] = {};
+
+        constexpr fixed_string(const char (&_str)[_N]) noexcept
+        {
+            for (size_t i = 0; i < _N; i++)
+                chars[i] = _str[i];
+        }
+
+        constexpr size_t size() const noexcept
+        {
+            return _N - 1;
+        }
+    };
+
+    namespace format_detail
+    {
+        /**
+         * @brief intentionally not constexpr: reaching this while parsing a format
+         * string at compile time makes compilation fail at the call site, with
+         * the message showing up in the diagnostic.
+         */
+        inline void invalid_format_string(const char *_message) noexcept
+        {
+            (void)_message;
+        }
+
+        /**
+         * @brief options of a single placeholder, "{:[width][.precision][x]}"
+         */
+        struct spec_t
+        {
+            size_t width = 0;
+            int precision = -1;
+            bool hex = false;
+        };
+
+        /**
+         * @brief pre-parsed format string. All literal text (with "{{" and "}}"
+         * already unescaped) is stored back to back, literal segment i ends at
+         * segment_end[i] and is followed by placeholder i (if i < placeholder_count).
+         */
+        template<size_t _P, size_t _L>
+        struct program_t
+        {
+            static constexpr size_t placeholder_count = _P;
+            static constexpr size_t literal_length = _L;
+
+            char text[_L + 1] = {};
+            size_t segment_end[_P + 1] = {};
+            spec_t specs[_P + 1] = {};
+        };
+
+        /**
+         * @brief walks the format string and reports every literal character
+         * and every placeholder to the provided callbacks
+         */
+        template<typename _LF, typename _PF>
+        constexpr void scan(const char *_fmt, size_t _n, _LF &&_on_literal, _PF &&_on_placeholder)
+        {
+            auto is_digit = [](char c) { return c >= '0' && c <= '9'; };
+            size_t i = 0;
+            while (i < _n)
+            {
+                char c = _fmt[i];
+                if (c == '{' && i + 1 < _n && _fmt[i + 1] == '{')
+                {
+                    _on_literal('{');
+                    i += 2;
+                }
+                else if (c == '{')
+                {
+                    spec_t spec;
+                    i++;
+                    if (i < _n && _fmt[i] == ':')
+                    {
+                        i++;
+                        while (i < _n && is_digit(_fmt[i]))
+                            spec.width = spec.width * 10 + (_fmt[i++] - '0');
+                        if (i < _n && _fmt[i] == '.')
+                        {
+                            i++;
+                            if (i >= _n || !is_digit(_fmt[i]))
+                                invalid_format_string("expected precision digits after '.'");
+                            spec.precision = 0;
+                            while (i < _n && is_digit(_fmt[i]))
+                                spec.precision = spec.precision * 10 + (_fmt[i++] - '0');
+                            if (spec.precision > 100)
+                                invalid_format_string("precision must not exceed 100");
+                        }
+                        if (i < _n && _fmt[i] == 'x')
+                        {
+                            spec.hex = true;
+                            i++;
+                        }
+                    }
+                    if (i >= _n || _fmt[i] != '}')
+                        invalid_format_string("unterminated or invalid placeholder");
+                    i++;
+                    _on_placeholder(spec);
+                }
+                else if (c == '}')
+                {
+                    if (i + 1 >= _n || _fmt[i + 1] != '}')
+                        invalid_format_string("unmatched '}' (use '}}' for a literal brace)");
+                    _on_literal('}');
+                    i += 2;
+                }
+                else
+                {
+                    _on_literal(c);
+                    i++;
+                }
+            }
+        }
+
+        template<fixed_string _Fmt>
+        constexpr auto parse()
+        {
+            constexpr auto sizes = []() {
+                std::pair<size_t, size_t> result{0, 0};
+                scan(_Fmt.chars, _Fmt.size(),
+                     [&](char) { result.second++; },
+                     [&](const spec_t &) { result.first++; });
+                return result;
+            }();
+
+            program_t<sizes.first, sizes.second> program;
+            size_t length = 0;
+            size_t index = 0;
+            scan(_Fmt.chars, _Fmt.size(),
+                 [&](char c) { program.text[length++] = c; },
+                 [&](const spec_t &spec) {
+                     program.segment_end[index] = length;
+                     program.specs[index++] = spec;
+                 });
+            program.segment_end[index] = length;
+            return program;
+        }
+
+        template<fixed_string _Fmt>
+        inline constexpr auto program_v = parse<_Fmt>();
+
+        /**
+         * @brief output that appends to an STL compatible string
+         */
+        template<typename _ST>
+        struct string_sink
+        {
+            _ST &out;
+
+            void put(const char *_data, size_t _n)
+            {
+                out.append(_data, _n);
+            }
+
+            void fill(char _c, size_t _n)
+            {
+                out.append(_n, _c);
+            }
+        };
+
+        /**
+         * @brief output that writes into a fixed size buffer, truncating but
+         * still counting what doesn't fit
+         */
+        struct buffer_sink
+        {
+            char *buffer;
+            size_t capacity;
+            size_t length = 0;
+
+            void put(const char *_data, size_t _n) noexcept
+            {
+                if (length < capacity)
+                    memcpy(buffer + length, _data, std::min(_n, capacity - length));
+                length += _n;
+            }
+
+            void fill(char _c, size_t _n) noexcept
+            {
+                if (length < capacity)
+                    memset(buffer + length, _c, std::min(_n, capacity - length));
+                length += _n;
+            }
+        };
+
+        template<typename _T>
+        inline constexpr bool unsupported_argument_v = false;
+
+        template<spec_t _Spec, typename _Sink>
+        void put_padded(_Sink &_sink, const char *_data, size_t _n)
+        {
+            if constexpr (_Spec.width > 0)
+            {
+                if (_Spec.width > _n)
+                    _sink.fill(' ', _Spec.width - _n);
+            }
+            _sink.put(_data, _n);
+        }
+
+        /**
+         * @brief formats a single argument according to the placeholder's options.
+         * Which writer is used is decided at compile time from the argument type,
+         * options that don't apply to the type are rejected.
+         */
+        template<spec_t _Spec, typename _Sink, typename _T>
+        void write_argument(_Sink &_sink, const _T &_value)
+        {
+            using value_t = std::remove_cv_t<_T>;
+
+            if constexpr (std::is_same_v<value_t, bool>)
+            {
+                static_assert(!_Spec.hex && _Spec.precision < 0, "bool arguments only support a width option");
+                if (_value)
+                    put_padded<_Spec>(_sink, "true", 4);
+                else
+                    put_padded<_Spec>(_sink, "false", 5);
+            }
+            else if constexpr (std::is_same_v<value_t, char>)
+            {
+                static_assert(!_Spec.hex && _Spec.precision < 0, "char arguments only support a width option");
+                put_padded<_Spec>(_sink, &_value, 1);
+            }
+            else if constexpr (std::is_integral_v<value_t>)
+            {
+                static_assert(_Spec.precision < 0, "precision '{:.N}' requires a floating point argument");
+                // to_chars would print negative values as "-ff" instead of their two's complement
+                static_assert(!_Spec.hex || std::is_unsigned_v<value_t>, "hex '{:x}' requires an unsigned integer argument");
+                char buffer[sizeof(value_t) * 8 + 1];
+                auto result = std::to_chars(buffer, buffer + sizeof(buffer), _value, _Spec.hex ? 16 : 10);
+                put_padded<_Spec>(_sink, buffer, result.ptr - buffer);
+            }
+            else if constexpr (std::is_floating_point_v<value_t>)
+            {
+                static_assert(!_Spec.hex, "hex '{:x}' requires an integer argument");
+                char buffer[512];
+                std::to_chars_result result;
+                if constexpr (_Spec.precision >= 0)
+                {
+                    result = std::to_chars(buffer, buffer + sizeof(buffer), _value, std::chars_format::fixed, _Spec.precision);
+                    // only huge long doubles don't fit in fixed notation
+                    if (result.ec != std::errc())
+                        result = std::to_chars(buffer, buffer + sizeof(buffer), _value, std::chars_format::scientific, _Spec.precision);
+                }
+                else
+                {
+                    result = std::to_chars(buffer, buffer + sizeof(buffer), _value);
+                }
+                put_padded<_Spec>(_sink, buffer, result.ptr - buffer);
+            }
+            else if constexpr (std::is_convertible_v<const _T &, std::string_view>)
+            {
+                static_assert(!_Spec.hex && _Spec.precision < 0, "string arguments only support a width option");
+                std::string_view view = _value;
+                put_padded<_Spec>(_sink, view.data(), view.size());
+            }
+            else
+            {
+                static_assert(unsupported_argument_v<_T>, "unsupported format argument type");
+            }
+        }
+
+        template<fixed_string _Fmt, size_t _I, typename _Sink>
+        void put_segment(_Sink &_sink)
+        {
+            constexpr auto &program = program_v<_Fmt>;
+            constexpr size_t begin = _I == 0 ? 0 : program.segment_end[_I - 1];
+            constexpr size_t end = program.segment_end[_I];
+            if constexpr (end > begin)
+                _sink.put(program.text + begin, end - begin);
+        }
+
+        /**
+         * @brief writes the pre-parsed format string to a sink. This unrolls
+         * into one literal put and one argument write per placeholder.
+         */
+        template<fixed_string _Fmt, typename _Sink, typename... _Args>
+        void run(_Sink &_sink, const _Args &..._args)
+        {
+            constexpr auto &program = program_v<_Fmt>;
+            static_assert(program.placeholder_count == sizeof...(_Args), "number of format arguments doesn't match the number of placeholders");
+
+            [&]<size_t... _I>(std::index_sequence<_I...>) {
+                ((put_segment<_Fmt, _I>(_sink), write_argument<program.specs[_I]>(_sink, _args)), ...);
+            }(std::index_sequence_for<_Args...>{});
+            put_segment<_Fmt, sizeof...(_Args)>(_sink);
+        }
+    }
+
+    /**
+     * @brief type-safe variant of format_to() with "{}" style placeholders.
+     * The format string is parsed at compile time and the number and types of
+     * arguments are checked against it. The output is always null terminated
+     * and truncated if the buffer is too small.
+     * 
+     * Placeholders have the form "{}" or "{:[width][.precision][x]}":
+     *  - width: minimum width, the value is right-aligned and padded with spaces
+     *  - .precision: fixed notation with that many decimals (floating point only)
+     *  - x: lowercase hexadecimal (unsigned integers only)
+     * Without a precision, floating point values use the shortest representation
+     * that round-trips. Literal braces are written as "{{" and "}}".
+     * Supported argument types are bool, char, integers, floating point numbers
+     * and anything convertible to std::string_view.
+     * 
+     * @tparam _Fmt Format string
+     * @tparam _Args format argument types (deducted)
+     * @param _buffer output buffer
+     * @param _size size of the output buffer in bytes (including space for the null byte)
+     * @param _args Format arguments
+     * @return size_t length of the complete formatted string (without null byte). If this is
+     * >= _size, the output was truncated.
+     */
+    template<fixed_string _Fmt, typename... _Args>
+    size_t format_to(char *_buffer, size_t _size, const _Args &..._args)
+    {
+        if (_size == 0)
+        {
+            format_detail::buffer_sink sink{_buffer, 0};
+            format_detail::run<_Fmt>(sink, _args...);
+            return sink.length;
+        }
+        format_detail::buffer_sink sink{_buffer, _size - 1};
+        format_detail::run<_Fmt>(sink, _args...);
+        _buffer[std::min(sink.length, _size - 1)] = '\0';
+        return sink.length;
+    }
+
+    /**
+     * @brief type-safe variant of format_append() with "{}" style placeholders
+     * (see format_to<_Fmt>() for the placeholder syntax).
+     * 
+     * @tparam _Fmt Format string
+     * @tparam _ST string type, typically std::string (can be deducted)
+     * @tparam _Args format argument types (deducted)
+     * @param _string The string to append to
+     * @param _args Format arguments
+     * @return size_t number of characters appended
+     */
+    template<fixed_string _Fmt, typename _ST, typename... _Args>
+    size_t format_append(_ST &_string, const _Args &..._args)
+    {
+        size_t old_size = _string.size();
+        format_detail::string_sink<_ST> sink{_string};
+        format_detail::run<_Fmt>(sink, _args...);
+        return _string.size() - old_size;
+    }
+
+    /**
+     * @brief type-safe variant of format() with "{}" style placeholders
+     * (see format_to<_Fmt>() for the placeholder syntax).
+     * 
+     * @tparam _Fmt Format string
+     * @tparam _ST return value string type, defaults to std::string
+     * @tparam _Args format argument types (deducted)
+     * @param _args Format arguments
+     * @return _ST newly created string of specified type
+     */
+    template<fixed_string _Fmt, typename _ST = std::string, typename... _Args>
+    _ST format(const _Args &..._args)
+    {
+        _ST result;
+        result.reserve(format_detail::program_v<_Fmt>.literal_length + 16 * sizeof...(_Args));
+        format_detail::string_sink<_ST> sink{result};
+        format_detail::run<_Fmt>(sink, _args...);
+        return result;
     }
 
+#endif  // __EL_ENABLE_CXX20
+
     /**
      * @brief creates a copy of a string with all lowercase letters.
-     * The tolower() C function is used to convert the letters. 
+     * The tolower() C function is used to convert the letters, so the result
+     * depends on the current C locale (locale mode). For plain ASCII text,
+     * to_lower_inplace() and to_lower() are much faster.
      * Any string class compatible with the C++ std::string class in terms
      * of iteration and uses "char" as the character type can be used.
      * 
@@ -60,54 +528,953 @@ namespace el::strutil
     _ST lowercase(_ST instr)
     {
         std::for_each(instr.begin(), instr.end(), [](char &c)
-                    { c = ::tolower(c); });
+                    { c = ::tolower((unsigned char)c); });
 
         return instr;
     }
 
     /**
-     * @brief creates a copy of a string with all lowercase letters.
-     * The tolower() C function is used to convert the letters. 
+     * @brief creates a copy of a string with all uppercase letters.
+     * The toupper() C function is used to convert the letters, so the result
+     * depends on the current C locale (locale mode). For plain ASCII text,
+     * to_upper_inplace() and to_upper() are much faster.
      * Any string class compatible with the C++ std::string class in terms
      * of iteration and uses "char" as the character type can be used.
      * 
      * @tparam _ST string type to be used (deducted, typically std::string)
      * @param instr the input string to convert
-     * @return _ST copy of the string in lowercase
+     * @return _ST copy of the string in uppercase
      */
     template<typename _ST>
     _ST uppercase(_ST instr)
     {
         std::for_each(instr.begin(), instr.end(), [](char &c)
-                    { c = ::toupper(c); });
+                    { c = ::toupper((unsigned char)c); });
 
         return instr;
     }
 
+#ifdef __EL_ENABLE_CXX17
+
+    namespace case_detail
+    {
+        /**
+         * @brief ASCII case conversion of a single character without branches
+         * 
+         * @tparam _Upper true to convert to uppercase, false for lowercase
+         */
+        template<bool _Upper>
+        constexpr char convert_char(char _c) noexcept
+        {
+            constexpr unsigned char first = _Upper ? 'a' : 'A';
+            unsigned char c = _c;
+            return (char)(c ^ ((unsigned char)(c - first) < 26) << 5);
+        }
+
+#ifdef __EL_STRUTIL_SSE2
+        /**
+         * @brief ASCII case conversion of 16 characters at once
+         */
+        template<bool _Upper>
+        inline __m128i convert_vector(__m128i _chars) noexcept
+        {
+            // shift the letter range to the bottom of the signed range, so a single
+            // signed compare checks both bounds
+            constexpr char first = _Upper ? 'a' : 'A';
+            const __m128i shift = _mm_set1_epi8((char)(128 - first));
+            const __m128i limit = _mm_set1_epi8((char)(-128 + 26));
+            const __m128i flip = _mm_set1_epi8(0x20);
+            __m128i is_letter = _mm_cmplt_epi8(_mm_add_epi8(_chars, shift), limit);
+            return _mm_xor_si128(_chars, _mm_and_si128(is_letter, flip));
+        }
+#endif
+
+        /**
+         * @brief ASCII case conversion of a whole range. _in and _out may be
+         * the same pointer (in-place conversion), but must not otherwise overlap.
+         */
+        template<bool _Upper>
+        inline void convert(const char *_in, char *_out, size_t _size) noexcept
+        {
+            size_t i = 0;
+#ifdef __EL_STRUTIL_SSE2
+            for (; i + 16 <= _size; i += 16)
+            {
+                __m128i chars = _mm_loadu_si128((const __m128i *)(_in + i));
+                _mm_storeu_si128((__m128i *)(_out + i), convert_vector<_Upper>(chars));
+            }
+#endif
+            for (; i < _size; i++)
+                _out[i] = convert_char<_Upper>(_in[i]);
+        }
+
+        /**
+         * @brief compares two ranges of the same size ignoring ASCII case
+         */
+        inline bool equal_folded(const char *_a, const char *_b, size_t _size) noexcept
+        {
+            size_t i = 0;
+#ifdef __EL_STRUTIL_SSE2
+            for (; i + 16 <= _size; i += 16)
+            {
+                __m128i a = convert_vector<false>(_mm_loadu_si128((const __m128i *)(_a + i)));
+                __m128i b = convert_vector<false>(_mm_loadu_si128((const __m128i *)(_b + i)));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) != 0xffff)
+                    return false;
+            }
+#endif
+            for (; i < _size; i++)
+                if (convert_char<false>(_a[i]) != convert_char<false>(_b[i]))
+                    return false;
+            return true;
+        }
+    }
+
+    /**
+     * @brief converts all ASCII uppercase letters (A-Z) in a buffer to lowercase.
+     * All other bytes, including UTF-8 sequences, are left unchanged and the
+     * locale is ignored (ASCII mode, see lowercase() for locale mode).
+     * 
+     * @param _data pointer to the characters to convert
+     * @param _size number of characters
+     */
+    inline void to_lower_inplace(char *_data, size_t _size) noexcept
+    {
+        case_detail::convert<false>(_data, _data, _size);
+    }
+
+    /**
+     * @brief converts all ASCII lowercase letters (a-z) in a buffer to uppercase.
+     * All other bytes, including UTF-8 sequences, are left unchanged and the
+     * locale is ignored (ASCII mode, see uppercase() for locale mode).
+     * 
+     * @param _data pointer to the characters to convert
+     * @param _size number of characters
+     */
+    inline void to_upper_inplace(char *_data, size_t _size) noexcept
+    {
+        case_detail::convert<true>(_data, _data, _size);
+    }
+
+#ifdef __EL_ENABLE_CXX20
+
+    /**
+     * @brief converts all ASCII uppercase letters in a span to lowercase
+     * (ASCII mode, see to_lower_inplace(char *, size_t))
+     * 
+     * @param _chars characters to convert
+     */
+    inline void to_lower_inplace(std::span<char> _chars) noexcept
+    {
+        case_detail::convert<false>(_chars.data(), _chars.data(), _chars.size());
+    }
+
+    /**
+     * @brief converts all ASCII lowercase letters in a span to uppercase
+     * (ASCII mode, see to_upper_inplace(char *, size_t))
+     * 
+     * @param _chars characters to convert
+     */
+    inline void to_upper_inplace(std::span<char> _chars) noexcept
+    {
+        case_detail::convert<true>(_chars.data(), _chars.data(), _chars.size());
+    }
+
+#endif  // __EL_ENABLE_CXX20
+
+    /**
+     * @brief writes an ASCII lowercase copy of a string to an output buffer
+     * (ASCII mode, see to_lower_inplace(char *, size_t)). No null byte is written.
+     * 
+     * @param _in the input string
+     * @param _out output buffer with space for at least _in.size() characters.
+     * It may be the input's own memory, but must not overlap it otherwise.
+     * @return size_t number of characters written (= _in.size())
+     */
+    inline size_t to_lower(std::string_view _in, char *_out) noexcept
+    {
+        case_detail::convert<false>(_in.data(), _out, _in.size());
+        return _in.size();
+    }
+
+    /**
+     * @brief writes an ASCII uppercase copy of a string to an output buffer
+     * (ASCII mode, see to_upper_inplace(char *, size_t)). No null byte is written.
+     * 
+     * @param _in the input string
+     * @param _out output buffer with space for at least _in.size() characters.
+     * It may be the input's own memory, but must not overlap it otherwise.
+     * @return size_t number of characters written (= _in.size())
+     */
+    inline size_t to_upper(std::string_view _in, char *_out) noexcept
+    {
+        case_detail::convert<true>(_in.data(), _out, _in.size());
+        return _in.size();
+    }
+
+    /**
+     * @brief compares two strings ignoring the case of ASCII letters
+     * (ASCII mode, all other bytes must match exactly). No copies are made,
+     * the case is folded on the fly 16 characters at a time.
+     * 
+     * @retval true the strings are equal except for case
+     */
+    inline bool iequals(std::string_view _a, std::string_view _b) noexcept
+    {
+        return _a.size() == _b.size() && case_detail::equal_folded(_a.data(), _b.data(), _a.size());
+    }
+
+    /**
+     * @brief checks whether a string starts with a prefix, ignoring the
+     * case of ASCII letters (see iequals())
+     * 
+     * @param _str the string to check
+     * @param _prefix the prefix
+     * @retval true _str starts with _prefix except for case
+     */
+    inline bool istarts_with(std::string_view _str, std::string_view _prefix) noexcept
+    {
+        return _str.size() >= _prefix.size() && case_detail::equal_folded(_str.data(), _prefix.data(), _prefix.size());
+    }
+
+    /**
+     * @brief hashes a string ignoring the case of ASCII letters, so strings
+     * that are equal according to iequals() have the same hash.
+     * 
+     * @param _str the string to hash
+     * @return size_t the hash value
+     */
+    inline size_t ihash(std::string_view _str) noexcept
+    {
+        auto mix_word = [](uint64_t _h, uint64_t _w) {
+            _h ^= _w;
+            _h = (_h << 29) | (_h >> 35);
+            return _h * 0x9e3779b97f4a7c15ull;
+        };
+
+        uint64_t h = 0x2545f4914f6cdd1dull ^ _str.size();
+        const char *p = _str.data();
+        size_t remaining = _str.size();
+        char folded[16];
+        uint64_t words[2];
+        while (remaining >= 16)
+        {
+            case_detail::convert<false>(p, folded, 16);
+            memcpy(words, folded, 16);
+            h = mix_word(mix_word(h, words[0]), words[1]);
+            p += 16;
+            remaining -= 16;
+        }
+        if (remaining > 0)
+        {
+            memset(folded, 0, sizeof(folded));
+            case_detail::convert<false>(p, folded, remaining);
+            memcpy(words, folded, 16);
+            h = mix_word(mix_word(h, words[0]), words[1]);
+        }
+
+        // splitmix64 finalizer
+        h ^= h >> 30;
+        h *= 0xbf58476d1ce4e5b9ull;
+        h ^= h >> 27;
+        h *= 0x94d049bb133111ebull;
+        h ^= h >> 31;
+        return (size_t)h;
+    }
+
+    /**
+     * @brief Transparent case-insensitive hash functor (see ihash()).
+     * Together with case_insensitive_equal, this allows unordered containers with
+     * string keys that are looked up ignoring case, also by std::string_view
+     * or const char * without constructing a key string (C++20).
+     */
+    struct case_insensitive_hash
+    {
+        using is_transparent = void;
+
+        size_t operator()(std::string_view _str) const noexcept
+        {
+            return ihash(_str);
+        }
+    };
+
+    /**
+     * @brief Transparent case-insensitive key equality functor (see iequals())
+     */
+    struct case_insensitive_equal
+    {
+        using is_transparent = void;
+
+        bool operator()(std::string_view _a, std::string_view _b) const noexcept
+        {
+            return iequals(_a, _b);
+        }
+    };
+
+    /**
+     * @return _str without leading characters contained in _chars
+     */
+    constexpr std::string_view trim_left(std::string_view _str, std::string_view _chars = " \t\r\n\f\v") noexcept
+    {
+        size_t first = _str.find_first_not_of(_chars);
+        return first == std::string_view::npos ? std::string_view() : _str.substr(first);
+    }
+
+    /**
+     * @return _str without trailing characters contained in _chars
+     */
+    constexpr std::string_view trim_right(std::string_view _str, std::string_view _chars = " \t\r\n\f\v") noexcept
+    {
+        size_t last = _str.find_last_not_of(_chars);
+        return last == std::string_view::npos ? std::string_view() : _str.substr(0, last + 1);
+    }
+
+    /**
+     * @brief removes leading and trailing whitespace (or the characters in _chars)
+     * without copying.
+     * 
+     * @param _str the string to trim
+     * @param _chars the characters to remove, whitespace by default
+     * @return std::string_view view of the trimmed part of _str
+     */
+    constexpr std::string_view trim(std::string_view _str, std::string_view _chars = " \t\r\n\f\v") noexcept
+    {
+        return trim_right(trim_left(_str, _chars), _chars);
+    }
+
+    namespace split_detail
+    {
+        /**
+         * @brief single character delimiter, searched with memchr
+         */
+        struct char_delimiter
+        {
+            char delimiter;
+
+            const char *find(const char *_p, const char *_end) const noexcept
+            {
+                if (_p == _end)
+                    return _end;
+                const char *hit = (const char *)memchr(_p, delimiter, _end - _p);
+                return hit == nullptr ? _end : hit;
+            }
+        };
+
+        /**
+         * @brief any character out of a set. Sets of up to 4 characters are
+         * searched 16 bytes at a time, larger ones with a lookup table.
+         */
+        struct set_delimiter
+        {
+            bool table[256] = {};
+            char chars[4] = {};
+            size_t count = 0;
+
+            set_delimiter(std::string_view _chars) noexcept
+                : count(_chars.size())
+            {
+                for (char c : _chars)
+                    table[(unsigned char)c] = true;
+                // unused slots repeat the first character, so they never add hits
+                for (size_t i = 0; i < 4; i++)
+                    chars[i] = i < count ? _chars[i] : (count ? _chars[0] : 0);
+            }
+
+            const char *find(const char *_p, const char *_end) const noexcept
+            {
+                if (count == 0)
+                    return _end;
+#ifdef __EL_STRUTIL_SSE2
+                if (count <= 4)
+                {
+                    const __m128i c0 = _mm_set1_epi8(chars[0]);
+                    const __m128i c1 = _mm_set1_epi8(chars[1]);
+                    const __m128i c2 = _mm_set1_epi8(chars[2]);
+                    const __m128i c3 = _mm_set1_epi8(chars[3]);
+                    while (_end - _p >= 16)
+                    {
+                        __m128i chunk = _mm_loadu_si128((const __m128i *)_p);
+                        __m128i hits = _mm_or_si128(
+                            _mm_or_si128(_mm_cmpeq_epi8(chunk, c0), _mm_cmpeq_epi8(chunk, c1)),
+                            _mm_or_si128(_mm_cmpeq_epi8(chunk, c2), _mm_cmpeq_epi8(chunk, c3)));
+                        int mask = _mm_movemask_epi8(hits);
+                        if (mask != 0)
+                            return _p + detail::lowest_bit((uint32_t)mask);
+                        _p += 16;
+                    }
+                }
+#endif
+                while (_p < _end && !table[(unsigned char)*_p])
+                    _p++;
+                return _p;
+            }
+        };
+    }
+
+    /**
+     * @brief lazy range of the tokens of a string, see split() and split_any().
+     * Tokens are string views into the original string, nothing is allocated.
+     * 
+     * @tparam _D delimiter finder type
+     */
+    template<typename _D>
+    class split_range
+    {
+        std::string_view text;
+        _D delimiter;
+
+    public:
+        class iterator
+        {
+            friend class split_range;
+
+            const split_range *range = nullptr;
+            const char *token_begin = nullptr;
+            const char *token_end = nullptr;
+            bool done = true;
+
+            iterator(const split_range *_range) noexcept
+                : range(_range)
+                , token_begin(_range->text.data())
+                , token_end(_range->delimiter.find(token_begin, token_begin + _range->text.size()))
+                , done(false)
+            {
+            }
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::string_view;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const std::string_view *;
+            using reference = std::string_view;
+
+            iterator() = default;
+
+            std::string_view operator*() const noexcept
+            {
+                return std::string_view(token_begin, token_end - token_begin);
+            }
+
+            iterator &operator++() noexcept
+            {
+                const char *end = range->text.data() + range->text.size();
+                if (token_end == end)
+                {
+                    done = true;
+                    return *this;
+                }
+                token_begin = token_end + 1;
+                token_end = range->delimiter.find(token_begin, end);
+                return *this;
+            }
+
+            iterator operator++(int) noexcept
+            {
+                iterator old = *this;
+                ++*this;
+                return old;
+            }
+
+            friend bool operator==(const iterator &_lhs, const iterator &_rhs) noexcept
+            {
+                if (_lhs.done || _rhs.done)
+                    return _lhs.done == _rhs.done;
+                return _lhs.token_begin == _rhs.token_begin;
+            }
+
+            friend bool operator!=(const iterator &_lhs, const iterator &_rhs) noexcept
+            {
+                return !(_lhs == _rhs);
+            }
+        };
+
+        split_range(std::string_view _text, _D _delimiter) noexcept
+            : text(_text)
+            , delimiter(_delimiter)
+        {
+        }
+
+        iterator begin() const noexcept
+        {
+            return iterator(this);
+        }
+
+        iterator end() const noexcept
+        {
+            return iterator();
+        }
+    };
+
+    /**
+     * @brief splits a string at every occurrence of a delimiter character.
+     * Like Python's str.split(sep), n delimiters always produce n + 1 tokens,
+     * which includes empty tokens between adjacent delimiters and at the ends
+     * (an empty string yields one empty token).
+     * The tokens are computed lazily while iterating and are views into _text,
+     * which has to outlive the range. The delimiter search uses memchr.
+     * 
+     * @param _text the string to split
+     * @param _delimiter the delimiter
+     * @return split_range<split_detail::char_delimiter> range of std::string_view tokens
+     */
+    inline split_range<split_detail::char_delimiter> split(std::string_view _text, char _delimiter) noexcept
+    {
+        return split_range<split_detail::char_delimiter>(_text, {_delimiter});
+    }
+
+    /**
+     * @brief splits a string at every character that is contained in _delimiters
+     * (see split() for the token rules). Sets of up to 4 delimiters are searched
+     * with SSE2 where available.
+     * 
+     * @param _text the string to split
+     * @param _delimiters the set of delimiter characters
+     * @return split_range<split_detail::set_delimiter> range of std::string_view tokens
+     */
+    inline split_range<split_detail::set_delimiter> split_any(std::string_view _text, std::string_view _delimiters) noexcept
+    {
+        return split_range<split_detail::set_delimiter>(_text, split_detail::set_delimiter(_delimiters));
+    }
+
+    /**
+     * @brief splits a string into at most _N parts. If there are more delimiters,
+     * the last part contains the rest of the string unsplit (e.g. "key=a=b" split
+     * into 2 parts at '=' gives "key" and "a=b").
+     * 
+     * @tparam _N maximum number of parts (deducted)
+     * @param _text the string to split
+     * @param _delimiter the delimiter
+     * @param _parts output array, parts after the returned count are left unchanged
+     * @return size_t number of parts written (1 to _N)
+     */
+    template<size_t _N>
+    size_t split_n(std::string_view _text, char _delimiter, std::array<std::string_view, _N> &_parts) noexcept
+    {
+        static_assert(_N > 0, "split_n needs room for at least one part");
+        size_t count = 0;
+        while (count + 1 < _N)
+        {
+            size_t position = _text.find(_delimiter);
+            if (position == std::string_view::npos)
+                break;
+            _parts[count++] = _text.substr(0, position);
+            _text.remove_prefix(position + 1);
+        }
+        _parts[count++] = _text;
+        return count;
+    }
+
+    /**
+     * @brief joins strings with a separator. The length of the result is computed
+     * first, so the result is allocated exactly once.
+     * 
+     * @tparam _ST return value string type, defaults to std::string
+     * @tparam _R range type, the elements must be convertible to std::string_view (deducted)
+     * @param _parts the strings to join
+     * @param _separator inserted between each two parts
+     * @return _ST the joined string
+     */
+    template<typename _ST = std::string, typename _R>
+    _ST join(const _R &_parts, std::string_view _separator)
+    {
+        size_t length = 0;
+        size_t count = 0;
+        for (const auto &part : _parts)
+        {
+            length += std::string_view(part).size();
+            count++;
+        }
+        if (count > 1)
+            length += _separator.size() * (count - 1);
+
+        _ST result;
+        result.reserve(length);
+        bool first = true;
+        for (const auto &part : _parts)
+        {
+            if (!first)
+                result.append(_separator.data(), _separator.size());
+            first = false;
+            std::string_view view(part);
+            result.append(view.data(), view.size());
+        }
+        return result;
+    }
+
+    /**
+     * @brief joins a list of strings with a separator, e.g. join({a, b, c}, ", ")
+     * (see join() for ranges)
+     */
+    template<typename _ST = std::string>
+    _ST join(std::initializer_list<std::string_view> _parts, std::string_view _separator)
+    {
+        return join<_ST, std::initializer_list<std::string_view>>(_parts, _separator);
+    }
+
+#endif  // __EL_ENABLE_CXX17
+
     /**
      * @brief Reads the entire content of a file and stores it in a string.
+     * The string is sized to the file length up front and filled with a single
+     * bulk read. If the file is shorter than reported (e.g. it was truncated or
+     * opened in text mode with line ending conversion) the string is shrunk to what
+     * was actually read, if it has grown in the meantime, reading continues until EOF.
+     * Streams that can't seek (pipes, FIFOs) are read until EOF as well.
+     * The eof/fail flags caused by reaching the end of the file are cleared again.
+     * If the file is not open, the string is cleared and 0 is returned.
      * @exception This function can trough any exception that the string or ifstream can.
      * 
      * @tparam _ST string type, typically std::string (can be deducted)
      * @param _file The file stream to read from
      * @param _string The string to store the file contents in. This will overwrite the string.
-     * @return The length of the file (= the number of characters copied to the string)
+     * @return The number of characters actually read (= the length of the string)
      */
     template<typename _ST>
     size_t read_file_into_string(std::ifstream &_file, _ST &_string)
     {
+        if (!_file.is_open())
+        {
+            _string.clear();
+            return 0;
+        }
+
         // get file length
+        std::streamoff length = -1;
         _file.seekg(0, std::ios::end);
-        std::streampos length = _file.tellg();
-        _file.seekg(0, std::ios::beg);
+        if (_file)
+        {
+            length = _file.tellg();
+            _file.seekg(0, std::ios::beg);
+        }
+        if (length < 0 || !_file)   // not seekable (e.g. a pipe), just read until EOF
+        {
+            _file.clear(_file.rdstate() & std::ios::badbit);
+            length = 0;
+        }
+
+        _string.resize((size_t)length);
+        size_t total = 0;
+        if (length > 0)
+        {
+            _file.read(&_string[0], length);
+            total = _file.gcount();
+        }
+
+        // the file may have grown since tellg(), keep reading in growing chunks
+        while (_file.good() && _file.peek() != std::ifstream::traits_type::eof())
+        {
+            _string.resize(std::max<size_t>(total * 2, 4096));
+            _file.read(&_string[total], _string.size() - total);
+            total += _file.gcount();
+        }
+        _string.resize(total);
+
+        if (_file.eof())
+            _file.clear(_file.rdstate() & std::ios::badbit);
+        return total;
+    }
+
+#ifdef __EL_ENABLE_CXX17
+
+    /**
+     * @brief Reads a text stream line by line without allocating per line.
+     * The stream is read in large chunks and lines are returned as string views
+     * into the internal buffer, which stay valid until the next call to next().
+     * Lines are split at '\n' (which is not included, like std::getline). A final
+     * line without a trailing newline is returned as well. Lines that span chunk
+     * boundaries are moved to the front of the buffer, which grows if a single
+     * line is longer than the buffer.
+     * 
+     * A line_reader can also be constructed from a string view (e.g. a
+     * mapped_file), in which case no data is copied at all.
+     */
+    class line_reader
+    {
+    public:
+        static constexpr size_t default_chunk_size = 1 << 20;
+
+    protected:
+        std::istream *stream = nullptr;
+        std::unique_ptr<char[]> buffer;
+        size_t capacity = 0;
+        const char *data = nullptr;
+        size_t data_size = 0;
+        size_t position = 0;    // start of the next line
+        size_t scanned = 0;     // everything before this is known to contain no newline
+        size_t lines = 0;
+        bool at_end = false;
+
+        /**
+         * @brief moves the incomplete line to the front of the buffer and reads the next chunk
+         */
+        void refill()
+        {
+            size_t carry = data_size - position;
+            if (carry > capacity / 2)
+            {
+                // keep reads at least half a chunk large
+                size_t new_capacity = capacity * 2;
+                std::unique_ptr<char[]> new_buffer(new char[new_capacity]);
+                memcpy(new_buffer.get(), buffer.get() + position, carry);
+                buffer = std::move(new_buffer);
+                capacity = new_capacity;
+            }
+            else if (carry > 0 && position > 0)
+            {
+                memmove(buffer.get(), buffer.get() + position, carry);
+            }
+            scanned -= position;
+            position = 0;
+
+            stream->read(buffer.get() + carry, capacity - carry);
+            size_t count = stream->gcount();
+            if (count == 0 || !stream->good())
+                at_end = true;
+            data = buffer.get();
+            data_size = carry + count;
+        }
+
+    public:
+        /**
+         * @brief creates a line reader for a stream. The stream should be opened in
+         * binary mode (on platforms that distinguish), and must outlive the reader.
+         * 
+         * @param _stream the stream to read from
+         * @param _chunk_size number of bytes to read at once
+         */
+        line_reader(std::istream &_stream, size_t _chunk_size = default_chunk_size)
+            : stream(&_stream)
+            , buffer(new char[std::max<size_t>(_chunk_size, 64)])
+            , capacity(std::max<size_t>(_chunk_size, 64))
+            , data(buffer.get())
+        {
+        }
+
+        /**
+         * @brief creates a line reader for text that is already in memory.
+         * The returned lines point into _text, which must outlive the reader.
+         * 
+         * @param _text the text to split into lines
+         */
+        line_reader(std::string_view _text) noexcept
+            : data(_text.data())
+            , data_size(_text.size())
+            , at_end(true)
+        {
+        }
+
+        line_reader(const line_reader &) = delete;
+        line_reader &operator=(const line_reader &) = delete;
+
+        /**
+         * @brief reads the next line
+         * 
+         * @param _line set to the line (without '\n') if one was read. It is
+         * valid until the next call.
+         * @retval true a line was read
+         * @retval false there are no more lines
+         */
+        bool next(std::string_view &_line)
+        {
+            for (;;)
+            {
+                const char *newline = (const char *)memchr(data + scanned, '\n', data_size - scanned);
+                if (newline != nullptr)
+                {
+                    size_t end = newline - data;
+                    _line = std::string_view(data + position, end - position);
+                    position = scanned = end + 1;
+                    lines++;
+                    return true;
+                }
+                scanned = data_size;
+
+                if (at_end)
+                {
+                    if (position == data_size)
+                        return false;
+                    _line = std::string_view(data + position, data_size - position);
+                    position = data_size;
+                    lines++;
+                    return true;
+                }
+                refill();
+            }
+        }
 
-        _string.reserve(length);
-        _string.assign( (std::istreambuf_iterator<char>(_file)  ), 
-                        (std::istreambuf_iterator<char>()       ));
-                    
-        return length;
+        /**
+         * @return number of lines returned so far
+         */
+        size_t line_count() const noexcept
+        {
+            return lines;
+        }
+
+        /**
+         * @retval true reading from the stream failed (not just ended)
+         */
+        bool error() const noexcept
+        {
+            return stream != nullptr && stream->bad();
+        }
+    };
+
+
+    namespace string_switch_detail
+    {
+        /**
+         * @brief intentionally not constexpr: reaching this while building
+         * a string_switch at compile time makes compilation fail
+         */
+        inline void duplicate_label() noexcept {}
+        inline void no_perfect_hash_found() noexcept {}
+        inline void unknown_label() noexcept {}
+
+        constexpr uint64_t hash(std::string_view _str, uint64_t _seed) noexcept
+        {
+            uint64_t h = _seed ^ (_str.size() * 0x9e3779b97f4a7c15ull);
+            for (char c : _str)
+                h = (h ^ (unsigned char)c) * 0x100000001b3ull;
+            return h ^ (h >> 29);
+        }
+
+        /**
+         * @return a power of two large enough that a collision free seed
+         * is usually found within a few attempts
+         */
+        constexpr size_t table_size_for(size_t _n) noexcept
+        {
+            size_t size = 8;
+            while (size < 4 * _n || size < _n * _n / 4)
+                size <<= 1;
+            return size;
+        }
     }
 
+    /**
+     * @brief Switch over a fixed set of strings using a perfect hash table
+     * built at compile time. Looking up a string computes one hash, reads one
+     * table slot and confirms the match with a single comparison, independent
+     * of the number of labels. Any string type convertible to std::string_view
+     * (including const char *) can be looked up without allocating.
+     * 
+     * Usage:
+     *   static constexpr el::strutil::string_switch commands("get", "set", "delete");
+     *   switch (commands(message))
+     *   {
+     *   case commands.case_of("get"):
+     *       ...
+     *   default:   // not one of the labels
+     *       ...
+     *   }
+     * 
+     * case_of() fails to compile for strings that are not a label,
+     * and so does a switch with duplicate labels.
+     * 
+     * @tparam _N number of labels (deducted)
+     */
+    template<size_t _N>
+    class string_switch
+    {
+        static_assert(_N > 0 && _N < 255, "string_switch supports 1 to 254 labels");
+
+    public:
+        static constexpr size_t npos = (size_t)-1;
+        static constexpr size_t table_size = string_switch_detail::table_size_for(_N);
+
+    protected:
+        static constexpr uint8_t empty_slot = 0xff;
+
+        std::string_view labels[_N] = {};
+        uint8_t table[table_size] = {};
+        uint64_t seed = 0;
+
+    public:
+        /**
+         * @brief builds the hash table for the given labels. The labels
+         * must outlive the switch (string literals usually do).
+         * 
+         * @param _labels the case labels, their index is their case value
+         */
+        template<typename... _Labels>
+        constexpr string_switch(const _Labels &..._labels) noexcept
+            : labels{std::string_view(_labels)...}
+        {
+            static_assert(sizeof...(_Labels) == _N, "wrong number of labels");
+
+            for (size_t i = 0; i < _N; i++)
+                for (size_t j = 0; j < i; j++)
+                    if (labels[i] == labels[j])
+                        string_switch_detail::duplicate_label();
+
+            for (uint64_t attempt = 0; attempt < 10000; attempt++)
+            {
+                seed = (attempt + 1) * 0xbf58476d1ce4e5b9ull;
+                for (size_t slot = 0; slot < table_size; slot++)
+                    table[slot] = empty_slot;
+
+                bool collision = false;
+                for (size_t i = 0; i < _N && !collision; i++)
+                {
+                    size_t slot = string_switch_detail::hash(labels[i], seed) & (table_size - 1);
+                    if (table[slot] != empty_slot)
+                        collision = true;
+                    table[slot] = (uint8_t)i;
+                }
+                if (!collision)
+                    return;
+            }
+            string_switch_detail::no_perfect_hash_found();
+        }
+
+        /**
+         * @brief looks up a string
+         * 
+         * @param _str the string to look up
+         * @return size_t the index of the matching label or npos if there is none
+         */
+        constexpr size_t operator()(std::string_view _str) const noexcept
+        {
+            uint8_t index = table[string_switch_detail::hash(_str, seed) & (table_size - 1)];
+            if (index == empty_slot || labels[index] != _str)
+                return npos;
+            return index;
+        }
+
+        /**
+         * @brief index of a label, meant to be used as a case value.
+         * When evaluated at compile time, unknown labels fail to compile.
+         * 
+         * @param _label one of the labels
+         * @return size_t index of the label (npos if it isn't one, at runtime)
+         */
+        constexpr size_t case_of(std::string_view _label) const noexcept
+        {
+            for (size_t i = 0; i < _N; i++)
+                if (labels[i] == _label)
+                    return i;
+            string_switch_detail::unknown_label();
+            return npos;
+        }
+
+        /**
+         * @return the label with the given index
+         */
+        constexpr std::string_view label(size_t _index) const noexcept
+        {
+            return labels[_index];
+        }
+
+        static constexpr size_t size() noexcept
+        {
+            return _N;
+        }
+    };
+
+    template<typename... _Labels>
+    string_switch(const _Labels &...) -> string_switch<sizeof...(_Labels)>;
+
+#endif  // __EL_ENABLE_CXX17
 
     /**
      * @brief stringswitch - a macro based wrapper for if statements
@@ -116,7 +1483,9 @@ namespace el::strutil
      * no namespace annotations unfortunately.
      * 
      * Limitations: variables created inside the block are local, every case
-     * has to use brackets if it is more than one statement in size
+     * has to use brackets if it is more than one statement in size.
+     * Every scase is a full string comparison, for many cases or hot code
+     * paths string_switch is the better choice.
      */
 
 #define stringswitch(strval) {\
@@ -70,7 +70,11 @@ namespace el::types
 
         std::string to_string() const noexcept
         {
+#ifdef __EL_ENABLE_CXX20
+            return strutil::format<"(r={:3}, g={:3}, b={:3})">(r, g, b);
+#else
             return strutil::format<std::string>("(r=%3d, g=%3d, b=%3d)", r, g, b);
+#endif
         }
 
         /**
@@ -122,7 +126,11 @@ namespace el::types
 
         std::string to_string() const noexcept
         {
+#ifdef __EL_ENABLE_CXX20
+            return strutil::format<"(r={:3.6}, g={:3.6}, b={:3.6})">(r, g, b);
+#else
             return strutil::format<std::string>("(r=%3lf, g=%3lf, b=%3lf)", r, g, b);
+#endif
         }
 
         /**
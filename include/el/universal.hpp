@@ -10,36 +10,129 @@ LICENSE file in the root directory of this source tree.
 
 universal_t is a universal object, like a variable of dynamic type.
 
-This header requires el::strutil (strutil.hpp). It can only be used if the
+The container is implemented as the class template basic_universal which is
+parameterized on the string type used for string values and the unit.
+el::universal uses std::string and el::pmr::universal uses std::pmr::string,
+so the strings of many values can be allocated from a single memory resource.
+el::shared_universal uses el::shared_string, so copies of string values share
+a reference counted buffer.
+
+This header requires C++17 (std::string_view, std::pmr) and el::strutil
+(strutil.hpp). Before universal became the basic_universal template it also
+compiled as C++14, this is no longer the case. It can only be used if the
 platform supports the required functions and standard headers.
 */
 
 #pragma once
 
+#include "cxxversions.h"
+#ifndef __EL_ENABLE_CXX17
+#error "el/universal.hpp requires C++17 or newer"
+#else
+
 #include <string>
+#include <string_view>
+#include <cstring>
 #include <iostream>
+#include <type_traits>
+#include <utility>
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#endif
 
 #include "strutil.hpp"
 #include "types.hpp"
+#include "clocks.hpp"
+#include "shared_string.hpp"
 
 namespace el
 {
-    class universal
+    /**
+     * @brief policies defining what happens to the string storage of a
+     * universal when it is assigned a value of another type.
+     */
+    namespace string_policy
     {
+        /**
+         * @brief clears the string content. Most string implementations keep the
+         * allocated capacity, so this only releases the content (default).
+         */
+        struct clear
+        {
+            template<typename _ST>
+            static void release(_ST &_s) noexcept
+            {
+                _s.clear();
+            }
+        };
+
+        /**
+         * @brief leaves the string untouched, content included. Both this and clear
+         * keep the capacity with common string implementations; the difference is
+         * that clear() writes to the string (and may release shared or external
+         * storage), while no_clear skips that write when a value alternates between
+         * string and other types, at the cost of keeping the old content in memory.
+         */
+        struct no_clear
+        {
+            template<typename _ST>
+            static void release(_ST &) noexcept
+            {}
+        };
+
+        /**
+         * @brief clears the string and returns its memory to the allocator.
+         * This saves memory but requires reallocation when a string is assigned again.
+         */
+        struct shrink_to_fit
+        {
+            template<typename _ST>
+            static void release(_ST &_s)
+            {
+                _s.clear();
+                _s.shrink_to_fit();
+            }
+        };
+    };
+
+    /**
+     * @brief enumeration for the type currently stored in a
+     * universal data container.
+     */
+    enum class universal_type_t
+    {
+        empty,
+        string,
+        integer,  // integer is 64 bit
+        floating, // double (64 bit)
+        boolean,
+        rgb24
+    };
+
+    /**
+     * @brief universal data container, see el::universal.
+     *
+     * @tparam _ST string type used to store string values and the unit.
+     * Must be a std::basic_string<char, ...> compatible type providing an allocator_type.
+     * @tparam _SP string policy (see el::string_policy) defining how the string storage is
+     * treated when the container switches from string to another type.
+     */
+    template<typename _ST = std::string, typename _SP = string_policy::clear>
+    class basic_universal
+    {
+        // bulk conversion kernels access the data directly
+        friend class universal_batch;
+
     public:
+        using string_type = _ST;
+        using string_policy_type = _SP;
+        using allocator_type = typename _ST::allocator_type;
+
         /**
          * @brief enumeration for the type currently stored in the
-         * universal data container.
+         * universal data container (shared by all basic_universal variants).
          */
-        enum class type_t
-        {
-            empty,
-            string,
-            integer,  // integer is 64 bit
-            floating, // double (64 bit)
-            boolean,
-            rgb24
-        };
+        using type_t = universal_type_t;
 
     protected:
         /**
@@ -48,11 +141,11 @@ namespace el
          */
         struct data_t
         {
-            std::string string;
-            int64_t integer;
-            double floating;
+            string_type string;
+            int64_t integer = 0;
+            double floating = 0;
             types::rgb24_t rgb24;
-            bool boolean;
+            bool boolean = false;
         };
 
         // current type of the universal container
@@ -68,86 +161,245 @@ namespace el
          * effect on type conversions and comparisons. It is simply additional information
          * that can be set and accessed by the user code.
          */
-        std::string unit = "";
+        string_type unit;
         
         /**
          * @brief a timestamp value that can be set and read using the set_timestamp()
          * and get_timestamp() methods. can be usefull when keeping track of changing data
          * to see how old the stored information is.
-         * (TODO: Currently, this is not automatically set on write but that is a 
-         * feature to consider in the future)
+         * If a timestamp source is configured using set_timestamp_source(), this
+         * is automatically set on every value assignment (operator=).
          */
         uint64_t timestamp = 0;
 
+        // clock source used to automatically timestamp value assignments (nullptr = disabled)
+        clocks::source_t timestamp_source = nullptr;
+
         // == Settings (flags) that might become configurable in the future == //
-        // whether string should be cleared when switching to another type. This adds memory allocation and deallocation time but saves on memory
-        bool conf_clear_string = true;
+        // whether assignments of a value identical to the current one (same type and value) should be skipped and not update the timestamp
+        bool conf_stamp_only_on_change = false;
 
     protected: // methods
         /**
-         * @brief method to clear the contents of the internal string if the current
-         * type is string and string clearing is enabled
+         * @brief method to release the contents of the internal string according
+         * to the string policy if the current type is string
          *
          */
         void clear_string()
         {
-            if (!conf_clear_string)
-                return;
-
             if (type == type_t::string)
-                data.string.clear();
+                string_policy_type::release(data.string);
+        }
+
+        /**
+         * @return true if assignments should check whether the value
+         * actually changes before writing and timestamping it.
+         */
+        bool check_unchanged() const
+        {
+            return timestamp_source != nullptr && conf_stamp_only_on_change;
+        }
+
+        /**
+         * @brief updates the timestamp from the configured source if
+         * automatic timestamping is enabled.
+         */
+        void stamp()
+        {
+            if (timestamp_source != nullptr)
+                timestamp = timestamp_source();
+        }
+
+        /**
+         * @return true if _other holds the same type and value as this object
+         */
+        bool same_value(const basic_universal &_other) const
+        {
+            if (type != _other.type)
+                return false;
+            switch (type)
+            {
+            case type_t::string:
+                return data.string == _other.data.string;
+            case type_t::integer:
+                return data.integer == _other.data.integer;
+            case type_t::floating:
+                return data.floating == _other.data.floating;
+            case type_t::boolean:
+                return data.boolean == _other.data.boolean;
+            case type_t::rgb24:
+                return data.rgb24 == _other.data.rgb24;
+            case type_t::empty:
+            default:
+                return true;
+            }
+        }
+
+        /**
+         * @brief takes the timestamp of an assigned universal: with a timestamp
+         * source configured the assignment is stamped, otherwise the timestamp
+         * of _other is taken over.
+         */
+        void stamp_from(const basic_universal &_other)
+        {
+            if (timestamp_source != nullptr)
+                stamp();
+            else
+                timestamp = _other.timestamp;
+        }
+
+        /**
+         * @brief creates a string_type using the allocator of this object
+         */
+        string_type make_string(std::string_view _s) const
+        {
+            return string_type(_s.data(), _s.size(), data.string.get_allocator());
         }
 
     public:
         // == constructors to initialize with any data type == //
 
         // empty initialization empty (no data)
-        universal() = default;
+        basic_universal() = default;
 
         // string initialization
-        universal(const std::string &_d)
+        basic_universal(const string_type &_d)
         {
             type = type_t::string;
             data.string = _d;
         };
+        // string move initialization
+        basic_universal(string_type &&_d)
+        {
+            type = type_t::string;
+            data.string = std::move(_d);
+        };
+        // string view initialization (e.g. from strings of other string types)
+        basic_universal(std::string_view _d)
+        {
+            type = type_t::string;
+            data.string.assign(_d.data(), _d.size());
+        };
         // c-string and string literal initialization.
         // (used for string literals and c-strings that would otherwise result in the bool overload being chosen)
-        universal(const char *_d)
+        basic_universal(const char *_d)
         {
             type = type_t::string;
             data.string = _d;
         };
         // integer literal initialization
-        universal(int _d)
+        basic_universal(int _d)
         {
             type = type_t::integer;
             data.integer = _d;
         };
         // integer initialization
-        universal(int64_t _d)
+        basic_universal(int64_t _d)
         {
             type = type_t::integer;
             data.integer = _d;
         };
         // floating point value initialization
-        universal(double _d)
+        basic_universal(double _d)
         {
             type = type_t::floating;
             data.floating = _d;
         };
         // boolean initialization
-        universal(bool _d)
+        basic_universal(bool _d)
         {
             type = type_t::boolean;
             data.boolean = _d;
         };
         // 24 bit RGB color initialization
-        universal(const types::rgb24_t &_d)
+        basic_universal(const types::rgb24_t &_d)
         {
             type = type_t::rgb24;
             data.rgb24 = _d;
         };
 
+        // == allocator-extended constructors == //
+
+        // empty initialization with an allocator used for the string and unit
+        explicit basic_universal(const allocator_type &_alloc)
+            : data{string_type(_alloc), 0, 0, types::rgb24_t(), false}
+            , unit(_alloc)
+        {}
+        // copy using a different allocator
+        basic_universal(const basic_universal &_other, const allocator_type &_alloc)
+            : type(_other.type)
+            , data{string_type(_other.data.string, _alloc), _other.data.integer, _other.data.floating, _other.data.rgb24, _other.data.boolean}
+            , unit(_other.unit, _alloc)
+            , timestamp(_other.timestamp)
+            , timestamp_source(_other.timestamp_source)
+            , conf_stamp_only_on_change(_other.conf_stamp_only_on_change)
+        {}
+        // move using a different allocator
+        basic_universal(basic_universal &&_other, const allocator_type &_alloc)
+            : type(_other.type)
+            , data{string_type(std::move(_other.data.string), _alloc), _other.data.integer, _other.data.floating, _other.data.rgb24, _other.data.boolean}
+            , unit(std::move(_other.unit), _alloc)
+            , timestamp(_other.timestamp)
+            , timestamp_source(_other.timestamp_source)
+            , conf_stamp_only_on_change(_other.conf_stamp_only_on_change)
+        {}
+        // initialization with any value and an allocator
+        template<typename _T, typename = std::enable_if_t<std::is_constructible_v<basic_universal, const _T &>>>
+        basic_universal(const _T &_d, const allocator_type &_alloc)
+            : basic_universal(_alloc)
+        {
+            *this = _d;
+        }
+
+        basic_universal(const basic_universal &) = default;
+        basic_universal(basic_universal &&) = default;
+
+        // universal copy assignment. Value and unit are copied, the timestamp
+        // configuration of this object is kept (see set_timestamp_source()).
+        basic_universal &operator=(const basic_universal &_other)
+        {
+            if (this == &_other || (check_unchanged() && same_value(_other)))
+                return *this;
+            if (_other.type == type_t::string)
+                data.string = _other.data.string;
+            else
+                clear_string();
+            type = _other.type;
+            data.integer = _other.data.integer;
+            data.floating = _other.data.floating;
+            data.rgb24 = _other.data.rgb24;
+            data.boolean = _other.data.boolean;
+            unit = _other.unit;
+            stamp_from(_other);
+            return *this;
+        }
+        // universal move assignment, like the copy assignment
+        basic_universal &operator=(basic_universal &&_other)
+        {
+            if (this == &_other || (check_unchanged() && same_value(_other)))
+                return *this;
+            if (_other.type == type_t::string)
+                data.string = std::move(_other.data.string);
+            else
+                clear_string();
+            type = _other.type;
+            data.integer = _other.data.integer;
+            data.floating = _other.data.floating;
+            data.rgb24 = _other.data.rgb24;
+            data.boolean = _other.data.boolean;
+            unit = std::move(_other.unit);
+            stamp_from(_other);
+            return *this;
+        }
+
+        /**
+         * @return the allocator used for the string and unit
+         */
+        allocator_type get_allocator() const
+        {
+            return data.string.get_allocator();
+        }
+
         /*
          * operator= to set any of the data values
          * it is advised to assign using operator= instead of
@@ -155,71 +407,102 @@ namespace el
          * updated by the operator.
          */
         // string copy assignment
-        universal &operator=(const std::string &_d)
+        basic_universal &operator=(const string_type &_d)
         {
+            if (check_unchanged() && type == type_t::string && data.string == _d)
+                return *this;
             type = type_t::string;
             data.string = _d;
+            stamp();
             return *this;
         }
         // string move assignment
-        universal &operator=(std::string &&_d)
+        basic_universal &operator=(string_type &&_d)
         {
+            if (check_unchanged() && type == type_t::string && data.string == _d)
+                return *this;
             type = type_t::string;
             data.string = std::move(_d);
+            stamp();
+            return *this;
+        }
+        // string view assignment (e.g. from strings of other string types)
+        basic_universal &operator=(std::string_view _d)
+        {
+            if (check_unchanged() && type == type_t::string && data.string == _d)
+                return *this;
+            type = type_t::string;
+            data.string.assign(_d.data(), _d.size());
+            stamp();
             return *this;
         }
         // c-string and string literal (copy) assignment.
         // (used for string literals and c-strings that would otherwise result in the bool overload being chosen)
-        universal &operator=(const char *_d)
+        basic_universal &operator=(const char *_d)
         {
+            if (check_unchanged() && type == type_t::string && data.string == _d)
+                return *this;
             type = type_t::string;
             data.string = _d;
+            stamp();
             return *this;
         }
         // integer literal assingment
-        universal &operator=(int _d)
+        basic_universal &operator=(int _d)
         {
             return *this = (int64_t)_d;
         }
         // integer assignment
-        universal &operator=(int64_t _d)
+        basic_universal &operator=(int64_t _d)
         {
+            if (check_unchanged() && type == type_t::integer && data.integer == _d)
+                return *this;
             clear_string();
             type = type_t::integer;
             data.integer = _d;
+            stamp();
             return *this;
         }
         // floating point assignment
-        universal &operator=(double _d)
+        basic_universal &operator=(double _d)
         {
+            if (check_unchanged() && type == type_t::floating && data.floating == _d)
+                return *this;
             clear_string();
             type = type_t::floating;
             data.floating = _d;
+            stamp();
             return *this;
         }
         // boolean assignment
-        universal &operator=(bool _d)
+        basic_universal &operator=(bool _d)
         {
+            if (check_unchanged() && type == type_t::boolean && data.boolean == _d)
+                return *this;
             clear_string();
             type = type_t::boolean;
             data.boolean = _d;
+            stamp();
             return *this;
         }
         // rgb color assignment
-        universal &operator=(const types::rgb24_t &_d)
+        basic_universal &operator=(const types::rgb24_t &_d)
         {
+            if (check_unchanged() && type == type_t::rgb24 && data.rgb24 == _d)
+                return *this;
             clear_string();
             type = type_t::rgb24;
             data.rgb24 = _d;
+            stamp();
             return *this;
         }
 
         // accessors for the unit and timestamp
-        void set_unit(const std::string &_unit)
+        void set_unit(std::string_view _unit)
         {
-            unit = _unit;
+            unit.assign(_unit.data(), _unit.size());
         }
-        std::string get_unit() const
+        const string_type &get_unit() const
         {
             return unit;
         }
@@ -233,40 +516,71 @@ namespace el
             return timestamp;
         }
 
+        /**
+         * @brief enables automatic timestamping of value assignments.
+         * After this, every operator= that assigns a value sets the timestamp to
+         * the value returned by _source. The unit of the timestamp is defined by
+         * the source (see el::clocks for available sources).
+         * @note The configuration belongs to this object: assigning another universal
+         * keeps it and stamps the assignment like any other value (slot = el::universal(x)).
+         * Without a source, the timestamp of the assigned universal is taken over.
+         * Copy construction copies the configuration along with the value.
+         *
+         * @param _source clock source function or nullptr to disable automatic timestamping
+         * @param _only_on_change if true, assignments of a value identical to the current one
+         * (same type and same value) are skipped and don't update the timestamp.
+         */
+        void set_timestamp_source(clocks::source_t _source, bool _only_on_change = false)
+        {
+            timestamp_source = _source;
+            conf_stamp_only_on_change = _only_on_change;
+        }
+        clocks::source_t get_timestamp_source() const
+        {
+            return timestamp_source;
+        }
+
         // accessor for the type
         type_t get_type() const
         {
             return type;
         }
 
+        // accessor for the internal string storage without copying it.
+        // The content is only meaningful if the type is type_t::string.
+        const string_type &get_string() const
+        {
+            return data.string;
+        }
+
         // to set to empty type and clear all data
         void clear()
         {
-            type = type_t::empty;
             clear_string();
+            type = type_t::empty;
         }
 
         // == type conversion operators == //
 
         // string conversion
-        std::string to_string() const
+        string_type to_string() const
         {
             switch (type)
             {
             case type_t::integer:
-                return std::to_string(data.integer);
+                return make_string(std::to_string(data.integer));
                 break;
 
             case type_t::floating:
-                return std::to_string(data.floating);
+                return make_string(std::to_string(data.floating));
                 break;
 
             case type_t::boolean:
-                return data.boolean ? "true" : "false";
+                return make_string(data.boolean ? "true" : "false");
                 break;
 
             case type_t::rgb24:
-                return data.rgb24.to_string();
+                return make_string(data.rgb24.to_string());
                 break;
 
             case type_t::string:
@@ -275,7 +589,7 @@ namespace el
 
             case type_t::empty:
             default: // invalid type returns empty
-                return "";
+                return make_string("");
             }
         }
         // integer conversion
@@ -357,7 +671,7 @@ namespace el
                 break;
 
             case type_t::boolean:
-                return types::rgb24_t(data.integer ? 0xffffff : 0);
+                return types::rgb24_t(data.boolean ? 0xffffff : 0);
                 break;
 
             case type_t::rgb24:
@@ -437,31 +751,31 @@ namespace el
         // == standard display operators == //
 
         // stream operator to output data
-        friend std::ostream &operator<<(std::ostream &_os, const universal &_data)
+        friend std::ostream &operator<<(std::ostream &_os, const basic_universal &_data)
         {
             switch (_data.type)
             {
-            case universal::type_t::empty:
+            case type_t::empty:
                 _os << "(empty)";
                 break;
 
-            case universal::type_t::string:
+            case type_t::string:
                 _os << _data.data.string;
                 break;
 
-            case universal::type_t::integer:
+            case type_t::integer:
                 _os << _data.data.integer;
                 break;
 
-            case universal::type_t::floating:
+            case type_t::floating:
                 _os << _data.data.floating;
                 break;
 
-            case universal::type_t::boolean:
+            case type_t::boolean:
                 _os << (_data.data.boolean ? "true" : "false");
                 break;
 
-            case universal::type_t::rgb24:
+            case type_t::rgb24:
                 _os << el::strutil::format<std::string>("(%d, %d, %d)", _data.data.rgb24.r, _data.data.rgb24.g, _data.data.rgb24.b);
                 break;
 
@@ -475,7 +789,7 @@ namespace el
         // == operators to compare universal data structure == //
 
         // base equals comparator between two universal data structures
-        friend bool operator==(const universal &lhs, const universal &rhs)
+        friend bool operator==(const basic_universal &lhs, const basic_universal &rhs)
         {
             // call type specific operators of lhs depending on type of rhs
             switch (rhs.type)
@@ -512,21 +826,25 @@ namespace el
         }
 
         // comparison operators for comparing to raw types (used by base operator)
-        friend bool operator==(const universal &lhs, const std::string &rhs)
+        friend bool operator==(const basic_universal &lhs, std::string_view rhs)
         {
             if (lhs.type != type_t::string)
                 return false;              // string is never equal to anything other than a string
             return lhs.data.string == rhs; // if it is a string, compare the strings
         }
-        friend bool operator==(const universal &lhs, const char *rhs)
+        friend bool operator==(const basic_universal &lhs, const string_type &rhs)
+        {
+            return lhs == std::string_view(rhs);
+        }
+        friend bool operator==(const basic_universal &lhs, const char *rhs)
         {
-            return lhs == std::string(rhs);
+            return lhs == std::string_view(rhs);
         }
-        friend bool operator==(const universal &lhs, const int rhs)
+        friend bool operator==(const basic_universal &lhs, const int rhs)
         {
             return lhs == (int64_t)rhs;
         }
-        friend bool operator==(const universal &lhs, const int64_t rhs)
+        friend bool operator==(const basic_universal &lhs, const int64_t rhs)
         {
             switch (lhs.type)
             {
@@ -554,7 +872,7 @@ namespace el
                 return false;
             }
         }
-        friend bool operator==(const universal &lhs, const double rhs)
+        friend bool operator==(const basic_universal &lhs, const double rhs)
         {
             switch (lhs.type)
             {
@@ -582,7 +900,7 @@ namespace el
                 return false;
             }
         }
-        friend bool operator==(const universal &lhs, const bool rhs)
+        friend bool operator==(const basic_universal &lhs, const bool rhs)
         {
             switch (lhs.type)
             {
@@ -610,7 +928,7 @@ namespace el
                 return false;
             }
         }
-        friend bool operator==(const universal &lhs, const types::rgb24_t &rhs)
+        friend bool operator==(const basic_universal &lhs, const types::rgb24_t &rhs)
         {
             switch (lhs.type)
             {
@@ -641,7 +959,7 @@ namespace el
         }
 
         // base less than comparator between two universal data structures
-        friend bool operator<(const universal &lhs, const el::universal &rhs)
+        friend bool operator<(const basic_universal &lhs, const basic_universal &rhs)
         {
             // call type specific operators of lhs depending on type of rhs
             switch (rhs.type)
@@ -678,21 +996,24 @@ namespace el
         }
 
         // less than operators for comparing raw types to universal data structure (used by base operator)
-        friend bool operator<(const universal &lhs, const std::string &rhs)
+        friend bool operator<(const basic_universal &lhs, std::string_view rhs)
         {
             // when comparing strings, use their length
             return lhs < (int64_t)rhs.length();
         }
-        friend bool operator<(const universal &lhs, const char *rhs)
+        friend bool operator<(const basic_universal &lhs, const string_type &rhs)
         {
-            // when comparing strings, use their length
-            return lhs < std::string(rhs);
+            return lhs < std::string_view(rhs);
+        }
+        friend bool operator<(const basic_universal &lhs, const char *rhs)
+        {
+            return lhs < std::string_view(rhs);
         }
-        friend bool operator<(const universal &lhs, const int rhs)
+        friend bool operator<(const basic_universal &lhs, const int rhs)
         {
             return lhs < (int64_t)rhs;
         }
-        friend bool operator<(const universal &lhs, const int64_t rhs)
+        friend bool operator<(const basic_universal &lhs, const int64_t rhs)
         {
             switch (lhs.type)
             {
@@ -723,7 +1044,7 @@ namespace el
                 return false;
             }
         }
-        friend bool operator<(const universal &lhs, const double rhs)
+        friend bool operator<(const basic_universal &lhs, const double rhs)
         {
             switch (lhs.type)
             {
@@ -754,7 +1075,7 @@ namespace el
                 return false;
             }
         }
-        friend bool operator<(const universal &lhs, const bool rhs)
+        friend bool operator<(const basic_universal &lhs, const bool rhs)
         {
             switch (lhs.type)
             {
@@ -785,7 +1106,7 @@ namespace el
                 return false;
             }
         }
-        friend bool operator<(const universal &lhs, const types::rgb24_t &rhs)
+        friend bool operator<(const basic_universal &lhs, const types::rgb24_t &rhs)
         {
             // color comares using brightness
             switch (lhs.type)
@@ -818,9 +1139,34 @@ namespace el
         }
 
         // compare operators derived from one of the above
-        friend inline bool operator!=(const universal &lhs, const universal &rhs) { return !(lhs == rhs); }
-        friend inline bool operator>(const universal &lhs, const universal &rhs) { return rhs < lhs; };
-        friend inline bool operator<=(const universal &lhs, const universal &rhs) { return !(lhs > rhs); };
-        friend inline bool operator>=(const universal &lhs, const universal &rhs) { return !(lhs < rhs); };
+        friend inline bool operator!=(const basic_universal &lhs, const basic_universal &rhs) { return !(lhs == rhs); }
+        friend inline bool operator>(const basic_universal &lhs, const basic_universal &rhs) { return rhs < lhs; };
+        friend inline bool operator<=(const basic_universal &lhs, const basic_universal &rhs) { return !(lhs > rhs); };
+        friend inline bool operator>=(const basic_universal &lhs, const basic_universal &rhs) { return !(lhs < rhs); };
     };
+
+    // universal data container using std::string for strings
+    using universal = basic_universal<std::string>;
+
+#if __has_include(<memory_resource>)
+    namespace pmr
+    {
+        /**
+         * @brief universal data container using std::pmr::string for strings.
+         * Construct it with a polymorphic_allocator (or store it in a pmr container)
+         * to allocate the string and unit from a std::pmr::memory_resource
+         * such as a monotonic_buffer_resource.
+         */
+        using universal = basic_universal<std::pmr::string>;
+    };
+#endif
+
+    /**
+     * @brief universal data container using el::shared_string for strings.
+     * Copies of string values share the string buffer instead of duplicating it,
+     * which makes distributing the same value to many receivers cheap.
+     */
+    using shared_universal = basic_universal<shared_string>;
 };
+
+#endif  // __EL_ENABLE_CXX17
@@ -0,0 +1,288 @@
+/*
+ELEKTRON © 2026 - now
+Written by melektron
+www.elektron.work
+16.10.26, 10:05
+All rights reserved.
+
+This source code is licensed under the Apache-2.0 license found in the
+LICENSE file in the root directory of this source tree.
+
+Batch conversion kernels converting spans of el::universal values to
+plain arrays of a single type. The results are identical to calling the
+scalar universal::to_xxx() methods on every element.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+
+#include "cxxversions.h"
+#ifdef __EL_ENABLE_CXX20
+
+#include <span>
+
+#include "universal.hpp"
+#include "types.hpp"
+
+namespace el
+{
+    /**
+     * @brief Collection of bulk conversion functions for spans of universal objects.
+     * The type tags of the input are first classified in chunks and each run of elements
+     * with the same type is then converted in its own loop without per-element type dispatch.
+     *
+     * @note Because universal stores its values in a fat per-element layout, the loads
+     * are strided and the possible vectorization is limited. If the values are
+     * available in columnar form, el::universal_column is the better choice.
+     */
+    class universal_batch
+    {
+    public:
+        using type_t = universal::type_t;
+        using size_type = std::size_t;
+
+    protected:
+        // number of type tags classified at once
+        static constexpr size_type chunk_size = 256;
+
+        /**
+         * @brief classifies the type tags of the first _n elements of _in in chunks
+         * and calls _fn(type, begin, end) for every run of elements with the same type.
+         */
+        template<typename _Fn>
+        static void for_each_run(const universal *_in, size_type _n, _Fn &&_fn)
+        {
+            type_t tags[chunk_size];
+
+            for (size_type chunk = 0; chunk < _n; chunk += chunk_size)
+            {
+                size_type chunk_len = std::min(chunk_size, _n - chunk);
+
+                // classify all tags of the chunk
+                for (size_type i = 0; i < chunk_len; i++)
+                    tags[i] = _in[chunk + i].type;
+
+                // find the runs within the chunk
+                size_type run_begin = 0;
+                for (size_type i = 1; i <= chunk_len; i++)
+                {
+                    if (i == chunk_len || tags[i] != tags[run_begin])
+                    {
+                        _fn(tags[run_begin], chunk + run_begin, chunk + i);
+                        run_begin = i;
+                    }
+                }
+            }
+        }
+
+    public:
+        /**
+         * @brief converts universal objects to double using the same
+         * rules as universal::to_double().
+         *
+         * @param _in input values
+         * @param _out output buffer
+         * @return size_type number of converted elements (the smaller of the two sizes)
+         */
+        static size_type to_double(std::span<const universal> _in, std::span<double> _out)
+        {
+            size_type n = std::min(_in.size(), _out.size());
+            const universal *in = _in.data();
+            double *out = _out.data();
+
+            for_each_run(in, n, [in, out](type_t _type, size_type _begin, size_type _end) {
+                switch (_type)
+                {
+                case type_t::integer:
+                    for (size_type i = _begin; i < _end; i++)
+                        out[i] = in[i].data.integer;
+                    break;
+
+                case type_t::floating:
+                    for (size_type i = _begin; i < _end; i++)
+                        out[i] = in[i].data.floating;
+                    break;
+
+                case type_t::boolean:
+                    for (size_type i = _begin; i < _end; i++)
+                        out[i] = in[i].data.boolean;
+                    break;
+
+                case type_t::rgb24:
+                    for (size_type i = _begin; i < _end; i++)
+                        out[i] = in[i].data.rgb24.to_packed();
+                    break;
+
+                case type_t::string:
+                    for (size_type i = _begin; i < _end; i++)
+                        out[i] = in[i].data.string.length();
+                    break;
+
+                case type_t::empty:
+                default:
+                    std::fill(out + _begin, out + _end, 0.0);
+                    break;
+                }
+            });
+
+            return n;
+        }
+
+        /**
+         * @brief converts universal objects to int64_t using the same
+         * rules as universal::to_int64_t().
+         *
+         * @param _in input values
+         * @param _out output buffer
+         * @return size_type number of converted elements (the smaller of the two sizes)
+         */
+        static size_type to_int64_t(std::span<const universal> _in, std::span<int64_t> _out)
+        {
+            size_type n = std::min(_in.size(), _out.size());
+            const universal *in = _in.data();
+            int64_t *out = _out.data();
+
+            for_each_run(in, n, [in, out](type_t _type, size_type _begin, size_type _end) {
+                switch (_type)
+                {
+                case type_t::integer:
+                    for (size_type i = _begin; i < _end; i++)
+                        out[i] = in[i].data.integer;
+                    break;
+
+                case type_t::floating:
+                    for (size_type i = _begin; i < _end; i++)
+                        out[i] = in[i].data.floating;
+                    break;
+
+                case type_t::boolean:
+                    for (size_type i = _begin; i < _end; i++)
+                        out[i] = in[i].data.boolean;
+                    break;
+
+                case type_t::rgb24:
+                    for (size_type i = _begin; i < _end; i++)
+                        out[i] = in[i].data.rgb24.to_packed();
+                    break;
+
+                case type_t::string:
+                    for (size_type i = _begin; i < _end; i++)
+                        out[i] = in[i].data.string.length();
+                    break;
+
+                case type_t::empty:
+                default:
+                    std::fill(out + _begin, out + _end, 0);
+                    break;
+                }
+            });
+
+            return n;
+        }
+
+        /**
+         * @brief converts universal objects to bool using the same
+         * rules as universal::to_bool().
+         *
+         * @param _in input values
+         * @param _out output buffer
+         * @return size_type number of converted elements (the smaller of the two sizes)
+         */
+        static size_type to_bool(std::span<const universal> _in, std::span<bool> _out)
+        {
+            size_type n = std::min(_in.size(), _out.size());
+            const universal *in = _in.data();
+            bool *out = _out.data();
+
+            for_each_run(in, n, [in, out](type_t _type, size_type _begin, size_type _end) {
+                switch (_type)
+                {
+                case type_t::integer:
+                    for (size_type i = _begin; i < _end; i++)
+                        out[i] = in[i].data.integer;
+                    break;
+
+                case type_t::floating:
+                    for (size_type i = _begin; i < _end; i++)
+                        out[i] = in[i].data.floating;
+                    break;
+
+                case type_t::boolean:
+                    for (size_type i = _begin; i < _end; i++)
+                        out[i] = in[i].data.boolean;
+                    break;
+
+                case type_t::rgb24:
+                    for (size_type i = _begin; i < _end; i++)
+                        out[i] = in[i].data.rgb24.to_packed();
+                    break;
+
+                case type_t::string:
+                    for (size_type i = _begin; i < _end; i++)
+                        out[i] = in[i].data.string.length();
+                    break;
+
+                case type_t::empty:
+                default:
+                    std::fill(out + _begin, out + _end, false);
+                    break;
+                }
+            });
+
+            return n;
+        }
+
+        /**
+         * @brief converts universal objects to rgb24_t using the same
+         * rules as universal::to_rgb24_t().
+         *
+         * @param _in input values
+         * @param _out output buffer
+         * @return size_type number of converted elements (the smaller of the two sizes)
+         */
+        static size_type to_rgb24_t(std::span<const universal> _in, std::span<types::rgb24_t> _out)
+        {
+            size_type n = std::min(_in.size(), _out.size());
+            const universal *in = _in.data();
+            types::rgb24_t *out = _out.data();
+
+            for_each_run(in, n, [in, out](type_t _type, size_type _begin, size_type _end) {
+                switch (_type)
+                {
+                case type_t::integer:
+                    for (size_type i = _begin; i < _end; i++)
+                        out[i] = types::rgb24_t(in[i].data.integer);
+                    break;
+
+                case type_t::floating:
+                    for (size_type i = _begin; i < _end; i++)
+                        out[i] = types::rgb24_t(in[i].data.floating);
+                    break;
+
+                case type_t::boolean:
+                    for (size_type i = _begin; i < _end; i++)
+                        out[i] = types::rgb24_t(in[i].data.boolean ? 0xffffff : 0);
+                    break;
+
+                case type_t::rgb24:
+                    for (size_type i = _begin; i < _end; i++)
+                        out[i] = in[i].data.rgb24;
+                    break;
+
+                case type_t::string:
+                case type_t::empty:
+                default:
+                    std::fill(out + _begin, out + _end, types::rgb24_t());
+                    break;
+                }
+            });
+
+            return n;
+        }
+    };
+};
+
+#endif  // __EL_ENABLE_CXX20
@@ -0,0 +1,491 @@
+/*
+ELEKTRON © 2026 - now
+Written by melektron
+www.elektron.work
+16.10.26, 12:40
+All rights reserved.
+
+This source code is licensed under the Apache-2.0 license found in the
+LICENSE file in the root directory of this source tree.
+
+Compact binary encoding of el::universal values. The encoder writes into a
+caller provided buffer and the reader decodes values without copying strings
+(string views point into the input buffer).
+
+Wire format of one value:
+ - 1 byte tag:
+    bits 0-2: type (universal::type_t)
+    bit 3:    boolean value (only for type boolean)
+    bit 4:    unit present
+    bit 5:    timestamp present
+ - payload depending on type:
+    empty:    nothing
+    string:   varint length + bytes
+    integer:  zigzag varint
+    floating: 8 byte IEEE 754 double, little endian
+    boolean:  nothing (value is in the tag)
+    rgb24:    3 bytes r, g, b
+ - if unit present: varint length + bytes
+ - if timestamp present: varint
+
+Varints are unsigned LEB128 (7 bits per byte, least significant group first).
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <cstring>
+#include <string>
+
+#include "cxxversions.h"
+#ifdef __EL_ENABLE_CXX17
+
+#include <string_view>
+
+#include "universal.hpp"
+#include "types.hpp"
+
+namespace el
+{
+    /**
+     * @brief binary encoder and zero-copy reader for universal values.
+     * See universal_codec.hpp for the wire format.
+     */
+    struct universal_codec
+    {
+        using type_t = universal::type_t;
+
+        // tag byte flags
+        static constexpr uint8_t tag_type_mask = 0x07;
+        static constexpr uint8_t tag_bool_value = 0x08;
+        static constexpr uint8_t tag_has_unit = 0x10;
+        static constexpr uint8_t tag_has_timestamp = 0x20;
+
+        // maximum length of a 64 bit varint
+        static constexpr size_t max_varint_size = 10;
+
+        static constexpr uint64_t zigzag_encode(int64_t _v) noexcept
+        {
+            return ((uint64_t)_v << 1) ^ (uint64_t)(_v >> 63);
+        }
+
+        static constexpr int64_t zigzag_decode(uint64_t _v) noexcept
+        {
+            return (int64_t)(_v >> 1) ^ -(int64_t)(_v & 1);
+        }
+
+        static constexpr size_t varint_size(uint64_t _v) noexcept
+        {
+            size_t n = 1;
+            while (_v >= 0x80)
+            {
+                _v >>= 7;
+                n++;
+            }
+            return n;
+        }
+
+        /**
+         * @return the number of bytes needed to encode _value
+         */
+        static size_t encoded_size(const universal &_value) noexcept
+        {
+            size_t n = 1;
+            switch (_value.get_type())
+            {
+            case type_t::string:
+                n += varint_size(_value.get_string().size()) + _value.get_string().size();
+                break;
+
+            case type_t::integer:
+                n += varint_size(zigzag_encode(_value.to_int64_t()));
+                break;
+
+            case type_t::floating:
+                n += 8;
+                break;
+
+            case type_t::rgb24:
+                n += 3;
+                break;
+
+            default:
+                break;
+            }
+
+            if (!_value.get_unit().empty())
+                n += varint_size(_value.get_unit().size()) + _value.get_unit().size();
+            if (_value.get_timestamp() != 0)
+                n += varint_size(_value.get_timestamp());
+
+            return n;
+        }
+
+        /**
+         * @brief streaming encoder writing into a caller provided buffer.
+         * If a value doesn't fit in the remaining space, nothing is written
+         * and the overflow flag is set.
+         */
+        class encoder
+        {
+            uint8_t *buffer;
+            size_t capacity;
+            size_t length = 0;
+            bool overflow_flag = false;
+
+            void put_byte(uint8_t _b) noexcept
+            {
+                buffer[length++] = _b;
+            }
+
+            void put_varint(uint64_t _v) noexcept
+            {
+                while (_v >= 0x80)
+                {
+                    put_byte((uint8_t)(_v | 0x80));
+                    _v >>= 7;
+                }
+                put_byte((uint8_t)_v);
+            }
+
+            void put_string(const std::string &_s) noexcept
+            {
+                put_varint(_s.size());
+                std::memcpy(buffer + length, _s.data(), _s.size());
+                length += _s.size();
+            }
+
+        public:
+            /**
+             * @param _buffer output buffer
+             * @param _capacity size of the output buffer in bytes
+             */
+            encoder(void *_buffer, size_t _capacity) noexcept
+                : buffer((uint8_t *)_buffer)
+                , capacity(_capacity)
+            {}
+
+            /**
+             * @brief encodes a value and appends it to the buffer.
+             * The unit is included if it is not empty and the timestamp
+             * if it is not zero.
+             *
+             * @retval true the value was written
+             * @retval false there was not enough space, the overflow flag was set
+             */
+            bool write(const universal &_value) noexcept
+            {
+                if (encoded_size(_value) > capacity - length)
+                {
+                    overflow_flag = true;
+                    return false;
+                }
+
+                type_t type = _value.get_type();
+                uint8_t tag = (uint8_t)type & tag_type_mask;
+                if (type == type_t::boolean && _value.to_bool())
+                    tag |= tag_bool_value;
+                if (!_value.get_unit().empty())
+                    tag |= tag_has_unit;
+                if (_value.get_timestamp() != 0)
+                    tag |= tag_has_timestamp;
+                put_byte(tag);
+
+                switch (type)
+                {
+                case type_t::string:
+                    put_string(_value.get_string());
+                    break;
+
+                case type_t::integer:
+                    put_varint(zigzag_encode(_value.to_int64_t()));
+                    break;
+
+                case type_t::floating:
+                {
+                    double d = _value.to_double();
+                    uint64_t bits;
+                    std::memcpy(&bits, &d, sizeof(bits));
+                    for (int i = 0; i < 8; i++)
+                        put_byte((uint8_t)(bits >> (i * 8)));
+                    break;
+                }
+
+                case type_t::rgb24:
+                {
+                    types::rgb24_t color = _value.to_rgb24_t();
+                    put_byte(color.r);
+                    put_byte(color.g);
+                    put_byte(color.b);
+                    break;
+                }
+
+                default:
+                    break;
+                }
+
+                if (tag & tag_has_unit)
+                    put_string(_value.get_unit());
+                if (tag & tag_has_timestamp)
+                    put_varint(_value.get_timestamp());
+
+                return true;
+            }
+
+            /**
+             * @return pointer to the start of the output buffer
+             */
+            const uint8_t *data() const noexcept
+            {
+                return buffer;
+            }
+
+            /**
+             * @return number of bytes written to the buffer
+             */
+            size_t size() const noexcept
+            {
+                return length;
+            }
+
+            /**
+             * @return number of bytes still available in the buffer
+             */
+            size_t remaining() const noexcept
+            {
+                return capacity - length;
+            }
+
+            /**
+             * @retval true a write failed because of insufficient space and the flag was not cleared since then
+             * @retval false no write failed
+             */
+            bool overflowed() const noexcept
+            {
+                return overflow_flag;
+            }
+
+            void clear_overflow() noexcept
+            {
+                overflow_flag = false;
+            }
+
+            /**
+             * @brief starts writing at the beginning of the buffer again
+             * and clears the overflow flag.
+             */
+            void reset() noexcept
+            {
+                length = 0;
+                overflow_flag = false;
+            }
+        };
+
+        /**
+         * @brief a decoded value. Strings refer to the input buffer of the reader
+         * and are only valid as long as that buffer is.
+         */
+        struct value_view
+        {
+            type_t type = type_t::empty;
+            int64_t integer = 0;
+            double floating = 0;
+            bool boolean = false;
+            types::rgb24_t rgb24;
+            std::string_view string;
+            std::string_view unit;
+            uint64_t timestamp = 0;
+
+            /**
+             * @return a universal object with copies of the value, unit and timestamp
+             */
+            universal to_universal() const
+            {
+                universal value;
+                switch (type)
+                {
+                case type_t::string:
+                    value = std::string(string);
+                    break;
+
+                case type_t::integer:
+                    value = integer;
+                    break;
+
+                case type_t::floating:
+                    value = floating;
+                    break;
+
+                case type_t::boolean:
+                    value = boolean;
+                    break;
+
+                case type_t::rgb24:
+                    value = rgb24;
+                    break;
+
+                default:
+                    break;
+                }
+                if (!unit.empty())
+                    value.set_unit(std::string(unit));
+                value.set_timestamp(timestamp);
+                return value;
+            }
+        };
+
+        /**
+         * @brief reads encoded values from a buffer without copying them.
+         * Malformed or truncated input stops the reader and sets the error flag.
+         */
+        class reader
+        {
+            const uint8_t *input;
+            size_t length;
+            size_t position = 0;
+            bool error_flag = false;
+
+            bool get_varint(uint64_t &_out) noexcept
+            {
+                _out = 0;
+                for (size_t i = 0; i < max_varint_size; i++)
+                {
+                    if (position >= length)
+                        return false;
+                    uint8_t b = input[position++];
+                    _out |= (uint64_t)(b & 0x7F) << (i * 7);
+                    if (!(b & 0x80))
+                        return true;
+                }
+                return false;
+            }
+
+            bool get_string(std::string_view &_out) noexcept
+            {
+                uint64_t len;
+                if (!get_varint(len) || len > length - position)
+                    return false;
+                _out = std::string_view((const char *)input + position, len);
+                position += len;
+                return true;
+            }
+
+        public:
+            /**
+             * @param _input buffer containing encoded values
+             * @param _length size of the buffer in bytes
+             */
+            reader(const void *_input, size_t _length) noexcept
+                : input((const uint8_t *)_input)
+                , length(_length)
+            {}
+
+            /**
+             * @brief decodes the next value
+             *
+             * @param _out value to store the result in
+             * @retval true a value was read
+             * @retval false the end of the input was reached or the input is malformed (see error())
+             */
+            bool next(value_view &_out) noexcept
+            {
+                if (error_flag || position >= length)
+                    return false;
+
+                size_t start = position;
+                uint8_t tag = input[position++];
+                _out = value_view();
+                _out.type = (type_t)(tag & tag_type_mask);
+
+                bool ok = true;
+                switch (_out.type)
+                {
+                case type_t::empty:
+                    break;
+
+                case type_t::string:
+                    ok = get_string(_out.string);
+                    break;
+
+                case type_t::integer:
+                {
+                    uint64_t v;
+                    ok = get_varint(v);
+                    _out.integer = zigzag_decode(v);
+                    break;
+                }
+
+                case type_t::floating:
+                {
+                    if (length - position < 8)
+                    {
+                        ok = false;
+                        break;
+                    }
+                    uint64_t bits = 0;
+                    for (int i = 0; i < 8; i++)
+                        bits |= (uint64_t)input[position++] << (i * 8);
+                    std::memcpy(&_out.floating, &bits, sizeof(bits));
+                    break;
+                }
+
+                case type_t::boolean:
+                    _out.boolean = tag & tag_bool_value;
+                    break;
+
+                case type_t::rgb24:
+                    if (length - position < 3)
+                    {
+                        ok = false;
+                        break;
+                    }
+                    _out.rgb24 = types::rgb24_t(input[position], input[position + 1], input[position + 2]);
+                    position += 3;
+                    break;
+
+                default:
+                    ok = false;
+                    break;
+                }
+
+                if (ok && (tag & tag_has_unit))
+                    ok = get_string(_out.unit);
+                if (ok && (tag & tag_has_timestamp))
+                    ok = get_varint(_out.timestamp);
+
+                if (!ok)
+                {
+                    position = start;
+                    error_flag = true;
+                }
+                return ok;
+            }
+
+            /**
+             * @return true if all input has been consumed
+             */
+            bool at_end() const noexcept
+            {
+                return position >= length;
+            }
+
+            /**
+             * @return true if malformed or truncated input was encountered
+             */
+            bool error() const noexcept
+            {
+                return error_flag;
+            }
+
+            /**
+             * @return number of bytes consumed so far
+             */
+            size_t consumed() const noexcept
+            {
+                return position;
+            }
+        };
+    };
+};
+
+#endif  // __EL_ENABLE_CXX17
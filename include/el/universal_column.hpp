@@ -0,0 +1,401 @@
+/*
+ELEKTRON © 2026 - now
+Written by melektron
+www.elektron.work
+16.10.26, 09:12
+All rights reserved.
+
+This source code is licensed under the Apache-2.0 license found in the
+LICENSE file in the root directory of this source tree.
+
+Columnar (struct-of-arrays) container for large collections of el::universal
+values. Instead of storing one fat universal object per element, the column
+keeps a byte array of type tags, an array of packed 8 byte numeric payloads
+and a separate arena for string contents. Consecutive elements of the same type
+are tracked as runs, so bulk operations can process each run with a tight,
+branch-free loop the compiler is able to vectorize.
+
+Only the value of each element is stored, unit and timestamp are not part of the column.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "cxxversions.h"
+#ifdef __EL_ENABLE_CXX20
+
+#include <span>
+
+#include "universal.hpp"
+#include "types.hpp"
+
+namespace el
+{
+    /**
+     * @brief Struct-of-arrays storage for a sequence of universal values.
+     * Elements are appended with push_back() and can be read back as
+     * universal objects with get(). For bulk processing, the column
+     * exposes the runs of homogeneous type (runs()) and typed views
+     * over them (view()), as well as bulk conversion functions such
+     * as to_double().
+     */
+    class universal_column
+    {
+    public:
+        using type_t = universal::type_t;
+        using size_type = std::size_t;
+
+        /**
+         * @brief describes a sequence of consecutive elements
+         * that all have the same type.
+         */
+        struct run_t
+        {
+            type_t type;
+            size_type begin;    // index of the first element of the run
+            size_type count;    // number of elements in the run
+        };
+
+        /**
+         * @brief read-only, span-like view over the payloads of a run,
+         * decoding each element to _T on access. _T must be the type
+         * matching the run: int64_t (integer), double (floating), bool (boolean)
+         * or types::rgb24_t (rgb24).
+         *
+         * @tparam _T value type of the run
+         */
+        template<typename _T>
+        class run_view
+        {
+            const std::uint64_t *first;
+            size_type len;
+
+        public:
+            run_view(const std::uint64_t *_first, size_type _len) noexcept
+                : first(_first)
+                , len(_len)
+            {}
+
+            size_type size() const noexcept
+            {
+                return len;
+            }
+
+            bool empty() const noexcept
+            {
+                return len == 0;
+            }
+
+            _T operator[](size_type _i) const noexcept
+            {
+                return decode<_T>(first[_i]);
+            }
+
+            /**
+             * @return the raw 8 byte payloads of the run
+             */
+            std::span<const std::uint64_t> raw() const noexcept
+            {
+                return std::span<const std::uint64_t>(first, len);
+            }
+        };
+
+    protected:
+        // one type tag per element (universal::type_t stored as a byte)
+        std::vector<std::uint8_t> tags;
+        // one 8 byte payload per element. For strings this is the index into string_offsets
+        std::vector<std::uint64_t> payloads;
+        // contents of all strings, stored back to back
+        std::string string_arena;
+        // start offsets of all strings in the arena with an additional end offset at the back
+        std::vector<size_type> string_offsets = {0};
+        // runs of consecutive elements with the same type
+        std::vector<run_t> run_list;
+
+    protected: // methods
+
+        /**
+         * @brief decodes a packed payload to the value type _T
+         */
+        template<typename _T>
+        static _T decode(std::uint64_t _raw) noexcept
+        {
+            if constexpr (std::is_same_v<_T, double>)
+            {
+                double d;
+                std::memcpy(&d, &_raw, sizeof(d));
+                return d;
+            }
+            else if constexpr (std::is_same_v<_T, bool>)
+                return _raw != 0;
+            else if constexpr (std::is_same_v<_T, types::rgb24_t>)
+                return types::rgb24_t((std::uint32_t)_raw);
+            else
+                return (_T)_raw;
+        }
+
+        /**
+         * @return length of the string with index _string_index in the arena
+         */
+        size_type string_length(std::uint64_t _string_index) const noexcept
+        {
+            return string_offsets[_string_index + 1] - string_offsets[_string_index];
+        }
+
+        /**
+         * @brief appends a type tag and payload and updates the run list
+         */
+        void append(type_t _type, std::uint64_t _payload)
+        {
+            size_type index = tags.size();
+            tags.push_back((std::uint8_t)_type);
+            payloads.push_back(_payload);
+
+            if (!run_list.empty() && run_list.back().type == _type)
+                run_list.back().count++;
+            else
+                run_list.push_back({_type, index, 1});
+        }
+
+    public:
+        universal_column() = default;
+
+        /**
+         * @brief reserves space for _n elements. String contents are
+         * not accounted for, use reserve_strings() for that.
+         *
+         * @param _n number of elements
+         */
+        void reserve(size_type _n)
+        {
+            tags.reserve(_n);
+            payloads.reserve(_n);
+        }
+
+        /**
+         * @brief reserves space for _chars characters in the string arena
+         */
+        void reserve_strings(size_type _chars)
+        {
+            string_arena.reserve(_chars);
+        }
+
+        /**
+         * @return the amount of elements in the column
+         */
+        size_type size() const noexcept
+        {
+            return tags.size();
+        }
+
+        /**
+         * @return true if there are no elements in the column
+         */
+        bool empty() const noexcept
+        {
+            return tags.empty();
+        }
+
+        /**
+         * @brief removes all elements from the column.
+         * Allocated memory is kept for re-use.
+         */
+        void clear() noexcept
+        {
+            tags.clear();
+            payloads.clear();
+            string_arena.clear();
+            string_offsets.resize(1);
+            run_list.clear();
+        }
+
+        /**
+         * @brief appends the value of a universal object to the column
+         */
+        void push_back(const universal &_value)
+        {
+            switch (_value.get_type())
+            {
+            case type_t::integer:
+                append(type_t::integer, (std::uint64_t)_value.to_int64_t());
+                break;
+
+            case type_t::floating:
+            {
+                double d = _value.to_double();
+                std::uint64_t raw;
+                std::memcpy(&raw, &d, sizeof(raw));
+                append(type_t::floating, raw);
+                break;
+            }
+
+            case type_t::boolean:
+                append(type_t::boolean, _value.to_bool());
+                break;
+
+            case type_t::rgb24:
+                append(type_t::rgb24, _value.to_rgb24_t().to_packed());
+                break;
+
+            case type_t::string:
+            {
+                string_arena += _value.get_string();
+                append(type_t::string, string_offsets.size() - 1);
+                string_offsets.push_back(string_arena.size());
+                break;
+            }
+
+            case type_t::empty:
+            default:
+                append(type_t::empty, 0);
+                break;
+            }
+        }
+
+        /**
+         * @return the type of the element at index _i
+         */
+        type_t type_at(size_type _i) const noexcept
+        {
+            return (type_t)tags[_i];
+        }
+
+        /**
+         * @return the contents of the string element at index _i. The view
+         * points into the string arena of the column and is invalidated
+         * by the next push_back() or clear(). If the element is not a string,
+         * an empty view is returned.
+         */
+        std::string_view string_at(size_type _i) const noexcept
+        {
+            if (type_at(_i) != type_t::string)
+                return std::string_view();
+            std::uint64_t index = payloads[_i];
+            return std::string_view(string_arena.data() + string_offsets[index], string_length(index));
+        }
+
+        /**
+         * @return a universal object holding the value of the element at index _i
+         */
+        universal get(size_type _i) const
+        {
+            std::uint64_t raw = payloads[_i];
+            switch (type_at(_i))
+            {
+            case type_t::integer:
+                return universal(decode<std::int64_t>(raw));
+
+            case type_t::floating:
+                return universal(decode<double>(raw));
+
+            case type_t::boolean:
+                return universal(decode<bool>(raw));
+
+            case type_t::rgb24:
+                return universal(decode<types::rgb24_t>(raw));
+
+            case type_t::string:
+                return universal(std::string(string_at(_i)));
+
+            case type_t::empty:
+            default:
+                return universal();
+            }
+        }
+
+        /**
+         * @return the type tags of all elements (one universal::type_t per byte)
+         */
+        std::span<const std::uint8_t> type_tags() const noexcept
+        {
+            return std::span<const std::uint8_t>(tags);
+        }
+
+        /**
+         * @return all runs of consecutive elements with the same type
+         * in order of the elements.
+         */
+        const std::vector<run_t> &runs() const noexcept
+        {
+            return run_list;
+        }
+
+        /**
+         * @brief creates a typed view over the elements of a run.
+         * @note _T must match the type of the run, see run_view. For string
+         * runs use string_at() instead.
+         *
+         * @tparam _T value type of the run
+         * @param _run a run as returned by runs()
+         */
+        template<typename _T>
+        run_view<_T> view(const run_t &_run) const noexcept
+        {
+            return run_view<_T>(payloads.data() + _run.begin, _run.count);
+        }
+
+        /**
+         * @brief converts all elements to double with the same rules as
+         * universal::to_double() and stores them in _out. Each run is converted
+         * in a separate loop without per-element type dispatch.
+         *
+         * @param _out output buffer. If it is smaller than the column, only
+         * the first _out.size() elements are converted.
+         * @return size_type number of elements written to _out
+         */
+        size_type to_double(std::span<double> _out) const noexcept
+        {
+            size_type n = std::min(_out.size(), size());
+            double *out = _out.data();
+            const std::uint64_t *in = payloads.data();
+
+            for (const run_t &run : run_list)
+            {
+                if (run.begin >= n)
+                    break;
+                size_type end = std::min(run.begin + run.count, n);
+
+                switch (run.type)
+                {
+                case type_t::integer:
+                    for (size_type i = run.begin; i < end; i++)
+                        out[i] = (double)(std::int64_t)in[i];
+                    break;
+
+                case type_t::floating:
+                    std::memcpy(out + run.begin, in + run.begin, (end - run.begin) * sizeof(double));
+                    break;
+
+                case type_t::boolean:
+                case type_t::rgb24:
+                    // booleans are stored as 0/1 and colors packed, which is exactly their numeric value
+                    for (size_type i = run.begin; i < end; i++)
+                        out[i] = (double)in[i];
+                    break;
+
+                case type_t::string:
+                    // strings convert to their length
+                    for (size_type i = run.begin; i < end; i++)
+                        out[i] = (double)string_length(in[i]);
+                    break;
+
+                case type_t::empty:
+                default:
+                    std::fill(out + run.begin, out + end, 0.0);
+                    break;
+                }
+            }
+
+            return n;
+        }
+    };
+};
+
+#endif  // __EL_ENABLE_CXX20
@@ -0,0 +1,648 @@
+/*
+ELEKTRON © 2026 - now
+Written by melektron
+www.elektron.work
+16.10.26, 18:50
+All rights reserved.
+
+This source code is licensed under the Apache-2.0 license found in the
+LICENSE file in the root directory of this source tree.
+
+Streaming CSV import and export of el::universal records.
+
+The reader infers the type of every unquoted field:
+    (empty)         empty
+    true / false    boolean
+    #rrggbb         rgb24
+    -123            integer (if it fits into int64_t)
+    1.5, 1e3, nan   floating
+    anything else   string
+Quoted fields are always strings, "" inside quotes is an escaped quote.
+Records end with \n, \r\n or \r. Every line is a record, so an empty line
+is a record with a single empty field (this is also how the writer writes such
+a record, and a record without fields).
+
+The writer produces the same format, so records survive a round trip including
+their types (strings that would be inferred as another type are quoted and
+floating point numbers always contain a '.' or exponent).
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <istream>
+#include <ostream>
+#include <thread>
+#include <algorithm>
+#include <charconv>
+#include <utility>
+
+#include "cxxversions.h"
+#ifdef __EL_ENABLE_CXX17
+
+#include <string_view>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define __EL_UNIVERSAL_CSV_SSE2
+#endif
+
+#include "universal.hpp"
+#include "types.hpp"
+#include "detail/bits.hpp"
+
+namespace el
+{
+    /**
+     * @brief reads CSV records into vectors of universal values.
+     *
+     * The input is either a stream, which is read in chunks of a fixed size,
+     * or a memory buffer (e.g. a memory mapped file). Field boundaries are found
+     * by scanning 16 bytes at a time for delimiters and line breaks (SSE2 if available).
+     * Numeric fields are parsed directly from the input buffer with std::from_chars,
+     * and the universal objects of the record vector are reused, so reading does not
+     * allocate except for strings longer than the capacity already available.
+     */
+    class universal_csv_reader
+    {
+    protected:
+        std::istream *input = nullptr;  // nullptr when reading from memory
+        std::vector<char> buffer;       // chunk buffer for stream input
+        const char *data = nullptr;     // current window of input
+        size_t length = 0;              // size of the window
+        size_t position = 0;            // start of the next record in the window
+        bool input_done = false;        // no more data can be read into the window
+        bool error_flag = false;
+        size_t records = 0;
+        char delimiter;
+        std::string scratch;            // unescaped content of quoted fields
+
+        /**
+         * @return pointer to the first delimiter, \n or \r in [_p, _end) or _end
+         */
+        const char *find_special(const char *_p, const char *_end) const noexcept
+        {
+#ifdef __EL_UNIVERSAL_CSV_SSE2
+            const __m128i d = _mm_set1_epi8(delimiter);
+            const __m128i lf = _mm_set1_epi8('\n');
+            const __m128i cr = _mm_set1_epi8('\r');
+            while (_end - _p >= 16)
+            {
+                __m128i chunk = _mm_loadu_si128((const __m128i *)_p);
+                __m128i hits = _mm_or_si128(_mm_cmpeq_epi8(chunk, d), _mm_or_si128(_mm_cmpeq_epi8(chunk, lf), _mm_cmpeq_epi8(chunk, cr)));
+                int mask = _mm_movemask_epi8(hits);
+                if (mask != 0)
+                    return _p + detail::lowest_bit((uint32_t)mask);
+                _p += 16;
+            }
+#endif
+            while (_p < _end && *_p != delimiter && *_p != '\n' && *_p != '\r')
+                _p++;
+            return _p;
+        }
+
+        /**
+         * @brief moves the unread data to the start of the buffer and reads
+         * more from the stream. The buffer grows if it is full.
+         *
+         * @retval true more data was read
+         * @retval false the stream has no more data
+         */
+        bool refill()
+        {
+            if (input == nullptr || input_done)
+                return false;
+
+            size_t remaining = length - position;
+            if (position > 0)
+                std::memmove(buffer.data(), buffer.data() + position, remaining);
+            else if (remaining == buffer.size())
+                buffer.resize(buffer.size() * 2);   // a single record is larger than the buffer
+            position = 0;
+            length = remaining;
+
+            input->read(buffer.data() + length, buffer.size() - length);
+            size_t got = (size_t)input->gcount();
+            length += got;
+            data = buffer.data();
+            if (got == 0 || !*input)
+                input_done = true;
+            if (input->bad())
+                error_flag = true;
+            return got > 0;
+        }
+
+        /**
+         * @brief tries to parse a complete record starting at position
+         *
+         * @retval 1 a record was parsed
+         * @retval 0 the window ends before the record does
+         * @retval -1 unterminated quote at the end of the input
+         */
+        int parse_record(std::vector<universal> &_record)
+        {
+            const char *p = data + position;
+            const char *end = data + length;
+
+            if (p == end)
+            {
+                position = length;
+                return 0;
+            }
+
+            size_t count = 0;
+            for (;;)
+            {
+                if (count == _record.size())
+                    _record.emplace_back();
+                universal &field = _record[count++];
+
+                if (*p == '"')
+                {
+                    // quoted field, always a string
+                    scratch.clear();
+                    const char *q = p + 1;
+                    for (;;)
+                    {
+                        const char *quote = (const char *)std::memchr(q, '"', end - q);
+                        if (quote == nullptr)
+                            return input_done ? -1 : 0;
+                        if (quote + 1 == end && !input_done)
+                            return 0;   // can't tell yet whether the quote is escaped
+                        scratch.append(q, quote - q);
+                        if (quote + 1 < end && quote[1] == '"')
+                        {
+                            scratch += '"';
+                            q = quote + 2;
+                            continue;
+                        }
+                        p = quote + 1;
+                        break;
+                    }
+                    field = std::string_view(scratch);
+                    // ignore anything between the closing quote and the next delimiter
+                    p = find_special(p, end);
+                }
+                else
+                {
+                    const char *field_end = find_special(p, end);
+                    if (field_end == end && !input_done)
+                        return 0;
+                    parse_field(std::string_view(p, field_end - p), field);
+                    p = field_end;
+                }
+
+                if (p == end)
+                {
+                    if (!input_done)
+                        return 0;
+                    break;
+                }
+                if (*p == delimiter)
+                {
+                    p++;
+                    if (p == end)
+                    {
+                        if (!input_done)
+                            return 0;
+                        // trailing delimiter at the end of the input: one more empty field
+                        if (count == _record.size())
+                            _record.emplace_back();
+                        _record[count++].clear();
+                        break;
+                    }
+                    continue;
+                }
+
+                // line break
+                if (*p == '\r')
+                {
+                    if (p + 1 == end && !input_done)
+                        return 0;
+                    p++;
+                    if (p < end && *p == '\n')
+                        p++;
+                }
+                else
+                {
+                    p++;
+                }
+                break;
+            }
+
+            _record.resize(count);
+            position = p - data;
+            return 1;
+        }
+
+    public:
+        /**
+         * @brief reads from a stream in chunks
+         *
+         * @param _input stream to read from
+         * @param _delimiter field separator
+         * @param _chunk_size number of bytes read from the stream at once
+         */
+        universal_csv_reader(std::istream &_input, char _delimiter = ',', size_t _chunk_size = 1 << 16)
+            : input(&_input)
+            , buffer(_chunk_size ? _chunk_size : 1)
+            , delimiter(_delimiter)
+        {
+            data = buffer.data();
+        }
+
+        /**
+         * @brief reads from memory. The data must stay valid while reading.
+         *
+         * @param _data complete CSV input
+         * @param _delimiter field separator
+         */
+        universal_csv_reader(std::string_view _data, char _delimiter = ',')
+            : data(_data.data())
+            , length(_data.size())
+            , input_done(true)
+            , delimiter(_delimiter)
+        {}
+
+        /**
+         * @brief converts the text of an unquoted field to a universal value
+         * if it represents a type other than string (see universal_csv.hpp).
+         *
+         * @retval true the field was converted and stored in _out
+         * @retval false the field is a string, _out was not modified
+         */
+        static bool parse_non_string(std::string_view _text, universal &_out)
+        {
+            const char *begin = _text.data();
+            const char *end = begin + _text.size();
+            if (_text.empty())
+            {
+                _out.clear();
+                return true;
+            }
+
+            char c = _text[0];
+            if ((c >= '0' && c <= '9') || c == '-' || c == '.' || c == 'n' || c == 'i')
+            {
+                int64_t i;
+                auto ri = std::from_chars(begin, end, i);
+                if (ri.ec == std::errc() && ri.ptr == end)
+                {
+                    _out = i;
+                    return true;
+                }
+                double d;
+                auto rd = std::from_chars(begin, end, d);
+                if (rd.ec == std::errc() && rd.ptr == end)
+                {
+                    _out = d;
+                    return true;
+                }
+            }
+            else if (_text == "true" || _text == "false")
+            {
+                _out = c == 't';
+                return true;
+            }
+            else if (c == '#' && _text.size() == 7)
+            {
+                uint32_t packed;
+                auto r = std::from_chars(begin + 1, end, packed, 16);
+                if (r.ec == std::errc() && r.ptr == end)
+                {
+                    _out = types::rgb24_t(packed);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * @brief converts the text of an unquoted field to a universal value
+         * with inferred type (see universal_csv.hpp).
+         */
+        static void parse_field(std::string_view _text, universal &_out)
+        {
+            if (!parse_non_string(_text, _out))
+                _out = _text;
+        }
+
+        /**
+         * @brief reads the next record
+         *
+         * @param _record vector that receives the fields. Existing elements are reused
+         * and the vector is resized to the number of fields.
+         * @retval true a record was read
+         * @retval false end of input or error (see error())
+         */
+        bool next(std::vector<universal> &_record)
+        {
+            if (error_flag)
+                return false;
+            for (;;)
+            {
+                int result = parse_record(_record);
+                if (result > 0)
+                {
+                    records++;
+                    return true;
+                }
+                if (result < 0)
+                {
+                    error_flag = true;
+                    return false;
+                }
+                if (!refill())
+                {
+                    if (!input_done)
+                        continue;
+                    // input finished, parse the last record without waiting for more
+                    if (position >= length)
+                        return false;
+                    result = parse_record(_record);
+                    if (result > 0)
+                    {
+                        records++;
+                        return true;
+                    }
+                    if (result < 0 || position < length)
+                        error_flag = true;
+                    return false;
+                }
+            }
+        }
+
+        /**
+         * @return number of records read so far
+         */
+        size_t record_count() const noexcept
+        {
+            return records;
+        }
+
+        /**
+         * @return true if the input is malformed (unterminated quote) or the stream failed
+         */
+        bool error() const noexcept
+        {
+            return error_flag;
+        }
+
+        /**
+         * @brief reads CSV data from memory using multiple threads. The data is split
+         * into _thread_count parts at record boundaries (respecting quoted line breaks)
+         * and every part is read by its own thread.
+         *
+         * @param _data complete CSV input
+         * @param _thread_count number of threads (0 uses std::thread::hardware_concurrency())
+         * @param _fn callback _fn(size_t part, const std::vector<universal> &record) called
+         * for every record. It is called concurrently from different threads, but the records
+         * of one part are passed in order and parts are numbered in the order of the input.
+         * @param _delimiter field separator
+         * @retval true all parts were read successfully
+         * @retval false a part contained malformed input
+         */
+        template<typename _Fn>
+        static bool read_parallel(std::string_view _data, size_t _thread_count, _Fn &&_fn, char _delimiter = ',')
+        {
+            if (_thread_count == 0)
+                _thread_count = std::max(1u, std::thread::hardware_concurrency());
+
+            // find split points: the first line break after the target position
+            // that is not inside quotes (quote parity counted from the last split)
+            std::vector<size_t> splits{0};
+            bool in_quotes = false;
+            size_t scanned = 0;
+            for (size_t k = 1; k < _thread_count; k++)
+            {
+                size_t target = std::max(_data.size() * k / _thread_count, splits.back());
+                if (target >= _data.size())
+                    break;
+                in_quotes ^= std::count(_data.begin() + scanned, _data.begin() + target, '"') & 1;
+                size_t i = target;
+                while (i < _data.size() && (in_quotes || _data[i] != '\n'))
+                {
+                    if (_data[i] == '"')
+                        in_quotes = !in_quotes;
+                    i++;
+                }
+                scanned = i;
+                if (i >= _data.size())
+                    break;
+                splits.push_back(i + 1);
+            }
+            splits.push_back(_data.size());
+
+            std::vector<char> failed(splits.size() - 1, 0);
+            std::vector<std::thread> threads;
+            for (size_t part = 0; part + 1 < splits.size(); part++)
+            {
+                threads.emplace_back([&, part]() {
+                    universal_csv_reader reader(_data.substr(splits[part], splits[part + 1] - splits[part]), _delimiter);
+                    std::vector<universal> record;
+                    while (reader.next(record))
+                        _fn(part, std::as_const(record));
+                    failed[part] = reader.error();
+                });
+            }
+            for (std::thread &t : threads)
+                t.join();
+            return std::find(failed.begin(), failed.end(), 1) == failed.end();
+        }
+    };
+
+    /**
+     * @brief writes universal values as CSV records.
+     *
+     * Output is collected in an internal buffer and written to the stream
+     * in large blocks. Numbers are formatted with std::to_chars directly into
+     * the buffer, so writing doesn't allocate.
+     */
+    class universal_csv_writer
+    {
+    protected:
+        std::ostream &output;
+        std::vector<char> buffer;
+        size_t length = 0;
+        char delimiter;
+        bool first_field = true;
+
+        void reserve(size_t _n)
+        {
+            if (buffer.size() - length < _n)
+            {
+                flush();
+                if (buffer.size() < _n)
+                    buffer.resize(_n);
+            }
+        }
+
+        void put(char _c)
+        {
+            reserve(1);
+            buffer[length++] = _c;
+        }
+
+        void put(std::string_view _s)
+        {
+            reserve(_s.size());
+            std::memcpy(buffer.data() + length, _s.data(), _s.size());
+            length += _s.size();
+        }
+
+        /**
+         * @return true if a string field has to be quoted to be read back as the same string
+         */
+        bool needs_quotes(std::string_view _s) const
+        {
+            if (_s.empty())
+                return true;    // an unquoted empty field is an empty value
+            for (char c : _s)
+            {
+                if (c == delimiter || c == '"' || c == '\n' || c == '\r')
+                    return true;
+            }
+            universal inferred;
+            return universal_csv_reader::parse_non_string(_s, inferred);
+        }
+
+        void put_string(std::string_view _s)
+        {
+            if (!needs_quotes(_s))
+            {
+                put(_s);
+                return;
+            }
+            put('"');
+            for (size_t start = 0;;)
+            {
+                size_t quote = _s.find('"', start);
+                put(_s.substr(start, quote - start));
+                if (quote == std::string_view::npos)
+                    break;
+                put("\"\"");
+                start = quote + 1;
+            }
+            put('"');
+        }
+
+    public:
+        /**
+         * @param _output stream to write to
+         * @param _delimiter field separator
+         * @param _buffer_size size of the output buffer
+         */
+        universal_csv_writer(std::ostream &_output, char _delimiter = ',', size_t _buffer_size = 1 << 16)
+            : output(_output)
+            , buffer(_buffer_size < 64 ? 64 : _buffer_size)
+            , delimiter(_delimiter)
+        {}
+
+        ~universal_csv_writer()
+        {
+            flush();
+        }
+
+        universal_csv_writer(const universal_csv_writer &) = delete;
+        universal_csv_writer &operator=(const universal_csv_writer &) = delete;
+
+        /**
+         * @brief appends a field to the current record
+         */
+        void write_field(const universal &_value)
+        {
+            if (!first_field)
+                put(delimiter);
+            first_field = false;
+
+            // longest number: 24 characters for a double, 20 for an int64
+            char num[32];
+            switch (_value.get_type())
+            {
+            case universal_type_t::string:
+                put_string(_value.get_string());
+                break;
+
+            case universal_type_t::integer:
+            {
+                auto r = std::to_chars(num, num + sizeof(num), _value.to_int64_t());
+                put(std::string_view(num, r.ptr - num));
+                break;
+            }
+
+            case universal_type_t::floating:
+            {
+                auto r = std::to_chars(num, num + sizeof(num) - 2, _value.to_double());
+                std::string_view text(num, r.ptr - num);
+                put(text);
+                // make sure it is read back as floating and not as integer
+                if (text.find_first_of(".eEni") == std::string_view::npos)
+                    put(".0");
+                break;
+            }
+
+            case universal_type_t::boolean:
+                put(_value.to_bool() ? std::string_view("true") : std::string_view("false"));
+                break;
+
+            case universal_type_t::rgb24:
+            {
+                static const char hex[] = "0123456789abcdef";
+                uint32_t packed = _value.to_rgb24_t().to_packed();
+                num[0] = '#';
+                for (int i = 0; i < 6; i++)
+                    num[1 + i] = hex[(packed >> (20 - i * 4)) & 0xF];
+                put(std::string_view(num, 7));
+                break;
+            }
+
+            case universal_type_t::empty:
+            default:
+                break;
+            }
+        }
+
+        /**
+         * @brief ends the current record
+         */
+        void end_record()
+        {
+            put('\n');
+            first_field = true;
+        }
+
+        /**
+         * @brief writes a complete record. A record without fields is
+         * written as an empty line and read back as one empty field.
+         *
+         * @param _values fields of the record
+         * @param _count number of fields
+         */
+        void write_record(const universal *_values, size_t _count)
+        {
+            for (size_t i = 0; i < _count; i++)
+                write_field(_values[i]);
+            end_record();
+        }
+
+        void write_record(const std::vector<universal> &_values)
+        {
+            write_record(_values.data(), _values.size());
+        }
+
+        /**
+         * @brief writes the buffered output to the stream
+         */
+        void flush()
+        {
+            if (length > 0)
+                output.write(buffer.data(), length);
+            length = 0;
+        }
+    };
+};
+
+#endif  // __EL_ENABLE_CXX17
@@ -0,0 +1,454 @@
+/*
+ELEKTRON © 2026 - now
+Written by melektron
+www.elektron.work
+16.10.26, 17:20
+All rights reserved.
+
+This source code is licensed under the Apache-2.0 license found in the
+LICENSE file in the root directory of this source tree.
+
+Insertion ordered dictionary mapping string keys to el::universal values,
+optimized for fast lookup by std::string_view.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <utility>
+#include <iterator>
+#include <functional>
+#include <algorithm>
+#include <type_traits>
+
+#include "cxxversions.h"
+#ifdef __EL_ENABLE_CXX17
+
+#include <string_view>
+
+#include "universal.hpp"
+#include "detail/group_probe.hpp"
+
+namespace el
+{
+    /**
+     * @brief Dictionary of universal values with string keys.
+     *
+     * Keys and values are stored in two contiguous arrays in insertion order,
+     * so iteration is fast and always yields the elements in the order they
+     * were added. A separate open addressing index maps keys to their position:
+     * For every index slot there is a control byte holding 7 bits of the key's hash
+     * and the slots are probed in groups of 16 (SSE2 if available) like in universal_map.
+     * The full hash of every key is stored as well, so strings are only compared if
+     * the hashes match and growing the index doesn't need to hash the keys again.
+     *
+     * Lookups take a std::string_view and never create a temporary std::string.
+     *
+     * @note Inserting may reallocate the arrays and invalidates iterators and references.
+     * Erasing is O(n) because it keeps the insertion order of the remaining elements.
+     */
+    class universal_dict
+    {
+    public:
+        using size_type = std::size_t;
+        using key_type = std::string;
+        using mapped_type = universal;
+
+        static constexpr size_type npos = (size_type)-1;
+
+    protected:
+        static constexpr size_type group_width = detail::group_width;
+        static constexpr int8_t ctrl_empty = detail::ctrl_empty;
+        static constexpr int8_t ctrl_deleted = detail::ctrl_deleted;
+
+        // elements in insertion order
+        std::vector<std::string> key_list;
+        std::vector<universal> value_list;
+        std::vector<size_t> hash_list;
+
+        // index: control bytes and element positions, one per slot
+        std::vector<int8_t> ctrl;
+        std::vector<uint32_t> positions;
+        // number of empty slots that can still be filled before the index needs to grow
+        size_type growth_left = 0;
+
+        static size_t hash_key(std::string_view _key) noexcept
+        {
+            return std::hash<std::string_view>()(_key);
+        }
+
+        /**
+         * @brief searches the index slot referring to a key
+         *
+         * @return index of the slot or ctrl.size() if not found
+         */
+        size_type find_slot(std::string_view _key, size_t _hash) const noexcept
+        {
+            return detail::find_slot(ctrl.data(), ctrl.size(), _hash, [&](size_type _slot) {
+                uint32_t pos = positions[_slot];
+                return hash_list[pos] == _hash && key_list[pos] == _key;
+            });
+        }
+
+        /**
+         * @brief finds the first empty or deleted slot in the probe sequence of a hash.
+         * The index must not be full.
+         */
+        size_type find_free_slot(size_t _hash) const noexcept
+        {
+            return detail::find_free_slot(ctrl.data(), ctrl.size(), _hash);
+        }
+
+        /**
+         * @brief rebuilds the index with _slot_count slots from the stored hashes.
+         * The new index is built separately, so the old one stays intact if allocating fails.
+         */
+        void rebuild_index(size_type _slot_count)
+        {
+            std::vector<int8_t> new_ctrl(_slot_count, ctrl_empty);
+            std::vector<uint32_t> new_positions(_slot_count, 0);
+            for (size_type i = 0; i < key_list.size(); i++)
+            {
+                size_type slot = detail::find_free_slot(new_ctrl.data(), _slot_count, hash_list[i]);
+                new_ctrl[slot] = detail::h2(hash_list[i]);
+                new_positions[slot] = (uint32_t)i;
+            }
+            ctrl.swap(new_ctrl);
+            positions.swap(new_positions);
+            growth_left = _slot_count - _slot_count / 8 - key_list.size();
+        }
+
+        /**
+         * @return number of index slots needed for _n elements
+         */
+        static size_type slots_for(size_type _n) noexcept
+        {
+            size_type needed = group_width;
+            while (needed - needed / 8 < _n)
+                needed *= 2;
+            return needed;
+        }
+
+        /**
+         * @brief makes space for at least one more element in the index
+         */
+        void prepare_insert()
+        {
+            if (growth_left > 0)
+                return;
+            if (ctrl.empty())
+                rebuild_index(group_width);
+            else if (slots_for(key_list.size() + 1) > ctrl.size())
+                rebuild_index(ctrl.size() * 2);
+            else
+                rebuild_index(ctrl.size());     // mostly deleted slots, clean them up
+        }
+
+        /**
+         * @brief appends a new element and adds it to the index. The key must not exist yet.
+         * Everything that can throw (creating the key and value, growing the arrays and the
+         * index) happens before anything is modified, so the dict stays unchanged on failure.
+         */
+        template<typename... _Args>
+        size_type insert_new(std::string_view _key, size_t _hash, _Args&&... _args)
+        {
+            std::string key(_key);
+            universal value(std::forward<_Args>(_args)...);
+            size_type size = key_list.size();
+            if (size == key_list.capacity() || size == value_list.capacity() || size == hash_list.capacity())
+                reserve_elements(size < 8 ? 8 : size * 2);
+            prepare_insert();
+
+            // the arrays have capacity left, so these moves can't throw
+            size_type position = key_list.size();
+            key_list.push_back(std::move(key));
+            value_list.push_back(std::move(value));
+            hash_list.push_back(_hash);
+
+            // only publish the slot once the element exists
+            size_type slot = find_free_slot(_hash);
+            if (ctrl[slot] == ctrl_empty)
+                growth_left--;
+            ctrl[slot] = detail::h2(_hash);
+            positions[slot] = (uint32_t)position;
+            return position;
+        }
+
+        /**
+         * @brief grows the capacity of all element arrays to at least _n
+         */
+        void reserve_elements(size_type _n)
+        {
+            key_list.reserve(_n);
+            value_list.reserve(_n);
+            hash_list.reserve(_n);
+        }
+
+    public:
+        /**
+         * @brief iterator over the elements in insertion order. Dereferencing yields
+         * a pair of references to the key and the value, so it can be used with
+         * structured bindings: for (auto [key, value] : dict)
+         */
+        template<bool _Const>
+        class iterator_base
+        {
+            friend class universal_dict;
+            template<bool _OConst>
+            friend class iterator_base;
+            using dict_ptr_t = std::conditional_t<_Const, const universal_dict *, universal_dict *>;
+            using value_ref_t = std::conditional_t<_Const, const universal &, universal &>;
+
+            dict_ptr_t dict = nullptr;
+            size_type index = 0;
+
+            iterator_base(dict_ptr_t _dict, size_type _index) noexcept
+                : dict(_dict)
+                , index(_index)
+            {}
+
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = std::pair<const std::string &, value_ref_t>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = value_type;
+
+            iterator_base() = default;
+
+            // allow conversion from mutable to const iterator
+            template<bool _OConst, typename = std::enable_if_t<_Const && !_OConst>>
+            iterator_base(const iterator_base<_OConst> &_other) noexcept
+                : dict(_other.dict)
+                , index(_other.index)
+            {}
+
+            const std::string &key() const noexcept
+            {
+                return dict->key_list[index];
+            }
+            value_ref_t value() const noexcept
+            {
+                return dict->value_list[index];
+            }
+            /**
+             * @return position of the element in insertion order
+             */
+            size_type position() const noexcept
+            {
+                return index;
+            }
+
+            reference operator*() const noexcept
+            {
+                return reference(key(), value());
+            }
+            reference operator[](difference_type _n) const noexcept
+            {
+                return *(*this + _n);
+            }
+
+            iterator_base &operator++() noexcept { index++; return *this; }
+            iterator_base operator++(int) noexcept { iterator_base old = *this; index++; return old; }
+            iterator_base &operator--() noexcept { index--; return *this; }
+            iterator_base operator--(int) noexcept { iterator_base old = *this; index--; return old; }
+            iterator_base &operator+=(difference_type _n) noexcept { index += _n; return *this; }
+            iterator_base &operator-=(difference_type _n) noexcept { index -= _n; return *this; }
+            friend iterator_base operator+(iterator_base _it, difference_type _n) noexcept { return _it += _n; }
+            friend iterator_base operator-(iterator_base _it, difference_type _n) noexcept { return _it -= _n; }
+            friend difference_type operator-(const iterator_base &_lhs, const iterator_base &_rhs) noexcept
+            {
+                return (difference_type)_lhs.index - (difference_type)_rhs.index;
+            }
+
+            friend bool operator==(const iterator_base &_lhs, const iterator_base &_rhs) noexcept { return _lhs.index == _rhs.index; }
+            friend bool operator!=(const iterator_base &_lhs, const iterator_base &_rhs) noexcept { return _lhs.index != _rhs.index; }
+            friend bool operator<(const iterator_base &_lhs, const iterator_base &_rhs) noexcept { return _lhs.index < _rhs.index; }
+        };
+
+        using iterator = iterator_base<false>;
+        using const_iterator = iterator_base<true>;
+
+        universal_dict() = default;
+
+        iterator begin() noexcept { return iterator(this, 0); }
+        iterator end() noexcept { return iterator(this, key_list.size()); }
+        const_iterator begin() const noexcept { return const_iterator(this, 0); }
+        const_iterator end() const noexcept { return const_iterator(this, key_list.size()); }
+
+        /**
+         * @return the amount of elements in the dictionary
+         */
+        size_type size() const noexcept
+        {
+            return key_list.size();
+        }
+
+        /**
+         * @return true if there are no elements in the dictionary
+         */
+        bool empty() const noexcept
+        {
+            return key_list.empty();
+        }
+
+        /**
+         * @return all keys in insertion order
+         */
+        const std::vector<std::string> &keys() const noexcept
+        {
+            return key_list;
+        }
+
+        /**
+         * @return all values in insertion order (same order as keys())
+         */
+        const std::vector<universal> &values() const noexcept
+        {
+            return value_list;
+        }
+
+        /**
+         * @brief removes all elements. Allocated memory is kept.
+         */
+        void clear() noexcept
+        {
+            key_list.clear();
+            value_list.clear();
+            hash_list.clear();
+            std::fill(ctrl.begin(), ctrl.end(), ctrl_empty);
+            growth_left = ctrl.size() - ctrl.size() / 8;
+        }
+
+        /**
+         * @brief allocates space so that _n elements can be stored without
+         * reallocating the element arrays or rebuilding the index
+         */
+        void reserve(size_type _n)
+        {
+            reserve_elements(_n);
+            size_type needed = slots_for(_n);
+            if (needed > ctrl.size())
+                rebuild_index(needed);
+        }
+
+        /**
+         * @return position of the element with key _key in insertion order or npos if not found
+         */
+        size_type index_of(std::string_view _key) const noexcept
+        {
+            size_type slot = find_slot(_key, hash_key(_key));
+            return slot == ctrl.size() ? npos : positions[slot];
+        }
+
+        /**
+         * @return iterator to the element with key _key or end() if not found
+         */
+        iterator find(std::string_view _key) noexcept
+        {
+            size_type pos = index_of(_key);
+            return pos == npos ? end() : iterator(this, pos);
+        }
+        const_iterator find(std::string_view _key) const noexcept
+        {
+            size_type pos = index_of(_key);
+            return pos == npos ? end() : const_iterator(this, pos);
+        }
+
+        /**
+         * @return pointer to the value with key _key or nullptr if not found
+         */
+        universal *get(std::string_view _key) noexcept
+        {
+            size_type pos = index_of(_key);
+            return pos == npos ? nullptr : &value_list[pos];
+        }
+        const universal *get(std::string_view _key) const noexcept
+        {
+            size_type pos = index_of(_key);
+            return pos == npos ? nullptr : &value_list[pos];
+        }
+
+        /**
+         * @return true if the dictionary contains an element with key _key
+         */
+        bool contains(std::string_view _key) const noexcept
+        {
+            return index_of(_key) != npos;
+        }
+
+        /**
+         * @brief appends a new element with value constructed from _args
+         * if there is no element with the key yet.
+         *
+         * @return pair of iterator to the element with the key and bool
+         * which is true if the element was inserted.
+         */
+        template<typename... _Args>
+        std::pair<iterator, bool> try_emplace(std::string_view _key, _Args&&... _args)
+        {
+            size_t hash = hash_key(_key);
+            size_type slot = find_slot(_key, hash);
+            if (slot != ctrl.size())
+                return {iterator(this, positions[slot]), false};
+            return {iterator(this, insert_new(_key, hash, std::forward<_Args>(_args)...)), true};
+        }
+
+        /**
+         * @brief assigns _value to the element with the key or appends a new
+         * element if there is none.
+         *
+         * @return pair of iterator to the element and bool which is true if the
+         * element was inserted.
+         */
+        template<typename _T>
+        std::pair<iterator, bool> insert_or_assign(std::string_view _key, _T &&_value)
+        {
+            auto result = try_emplace(_key, std::forward<_T>(_value));
+            if (!result.second)
+                value_list[result.first.index] = std::forward<_T>(_value);
+            return result;
+        }
+
+        /**
+         * @return reference to the value with the key, which is
+         * appended as empty value if it didn't exist yet.
+         */
+        universal &operator[](std::string_view _key)
+        {
+            return value_list[try_emplace(_key).first.index];
+        }
+
+        /**
+         * @brief removes the element with key _key if it exists. The remaining
+         * elements keep their order.
+         *
+         * @return number of removed elements (0 or 1)
+         */
+        size_type erase(std::string_view _key)
+        {
+            size_type slot = find_slot(_key, hash_key(_key));
+            if (slot == ctrl.size())
+                return 0;
+
+            uint32_t pos = positions[slot];
+            ctrl[slot] = ctrl_deleted;
+            key_list.erase(key_list.begin() + pos);
+            value_list.erase(value_list.begin() + pos);
+            hash_list.erase(hash_list.begin() + pos);
+
+            // elements after the removed one moved down by one
+            for (size_type i = 0; i < ctrl.size(); i++)
+            {
+                if (ctrl[i] >= 0 && positions[i] > pos)
+                    positions[i]--;
+            }
+            return 1;
+        }
+    };
+};
+
+#endif  // __EL_ENABLE_CXX17
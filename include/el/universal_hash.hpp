@@ -0,0 +1,263 @@
+/*
+ELEKTRON © 2026 - now
+Written by melektron
+www.elektron.work
+16.10.26, 11:20
+All rights reserved.
+
+This source code is licensed under the Apache-2.0 license found in the
+LICENSE file in the root directory of this source tree.
+
+Hashing support for el::universal. This header adds transparent hash and key
+equality functors that can be used for (heterogeneous) lookup in unordered containers.
+
+There is intentionally no std::hash specialization for el::universal: the default
+equality of unordered containers is operator==, which is lossy and not transitive,
+so it is inconsistent with any hash. Always pass both functors, e.g.
+    std::unordered_map<el::universal, int, el::universal_hash, el::universal_key_equal>
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <cstring>
+#include <string>
+#include <functional>
+
+#include "cxxversions.h"
+#ifdef __EL_ENABLE_CXX17
+
+#include <string_view>
+
+#include "universal.hpp"
+#include "types.hpp"
+
+namespace el
+{
+    /**
+     * @brief Transparent hash functor for universal objects and raw values.
+     *
+     * Numeric values (integer, floating, boolean and rgb24 as packed integer)
+     * hash by their mathematical value, so values that represent the same
+     * number hash the same regardless of their type (1 == 1.0 == true == rgb24_t(0, 0, 1)).
+     * Strings hash by their content and all empty values hash the same.
+     *
+     * @note universal::operator== also performs lossy conversions (e.g. any non-zero
+     * number equals true, doubles are truncated when compared to colors). These
+     * are not transitive and can therefore not be reflected by any useful hash. Use
+     * universal_key_equal, which compares exact values, as the equality in hash containers.
+     */
+    struct universal_hash
+    {
+        using is_transparent = void;
+
+        /**
+         * @brief mixes the bits of a 64 bit value (splitmix64 finalizer)
+         * so all bits of the hash depend on all input bits.
+         */
+        static constexpr uint64_t mix(uint64_t _x) noexcept
+        {
+            _x ^= _x >> 30;
+            _x *= 0xbf58476d1ce4e5b9ull;
+            _x ^= _x >> 27;
+            _x *= 0x94d049bb133111ebull;
+            _x ^= _x >> 31;
+            return _x;
+        }
+
+        /**
+         * @brief checks whether a double represents an integer that can be stored in int64_t
+         *
+         * @param _d the value to check
+         * @param _out set to the integer value if the function returns true
+         */
+        static bool double_as_integer(double _d, int64_t &_out) noexcept
+        {
+            // the range check also filters out NaN
+            if (!(_d >= -9223372036854775808.0 && _d < 9223372036854775808.0))
+                return false;
+            _out = (int64_t)_d;
+            return (double)_out == _d;
+        }
+
+        size_t operator()(int64_t _v) const noexcept
+        {
+            return (size_t)mix((uint64_t)_v);
+        }
+        size_t operator()(int _v) const noexcept
+        {
+            return (*this)((int64_t)_v);
+        }
+        size_t operator()(double _v) const noexcept
+        {
+            int64_t i;
+            if (double_as_integer(_v, i))
+                return (*this)(i);
+            uint64_t bits;
+            std::memcpy(&bits, &_v, sizeof(bits));
+            return (size_t)mix(bits);
+        }
+        size_t operator()(bool _v) const noexcept
+        {
+            return (*this)((int64_t)_v);
+        }
+        size_t operator()(const types::rgb24_t &_v) const noexcept
+        {
+            return (*this)((int64_t)_v.to_packed());
+        }
+        size_t operator()(std::string_view _v) const noexcept
+        {
+            return std::hash<std::string_view>()(_v);
+        }
+        size_t operator()(const std::string &_v) const noexcept
+        {
+            return (*this)(std::string_view(_v));
+        }
+        size_t operator()(const char *_v) const noexcept
+        {
+            return (*this)(std::string_view(_v));
+        }
+        size_t operator()(const universal &_v) const noexcept
+        {
+            switch (_v.get_type())
+            {
+            case universal::type_t::integer:
+                return (*this)(_v.to_int64_t());
+
+            case universal::type_t::floating:
+                return (*this)(_v.to_double());
+
+            case universal::type_t::boolean:
+                return (*this)(_v.to_bool());
+
+            case universal::type_t::rgb24:
+                return (*this)(_v.to_rgb24_t());
+
+            case universal::type_t::string:
+                return (*this)(std::string_view(_v.get_string()));
+
+            case universal::type_t::empty:
+            default:
+                return 0;
+            }
+        }
+    };
+
+    /**
+     * @brief Transparent key equality functor for universal objects and raw values
+     * matching universal_hash. Numeric values are equal if they represent exactly the same
+     * number, strings are equal if their contents are equal and empty is only equal to empty.
+     * Unit and timestamp are ignored.
+     */
+    struct universal_key_equal
+    {
+        using is_transparent = void;
+
+    protected:
+        /**
+         * @brief numeric value normalized to an integer whenever it is representable as one
+         */
+        struct numeric_t
+        {
+            bool valid;         // false if the value is not numeric
+            bool is_integer;
+            int64_t integer;
+            double floating;
+        };
+
+        static numeric_t normalize(double _d) noexcept
+        {
+            int64_t i;
+            if (universal_hash::double_as_integer(_d, i))
+                return {true, true, i, 0};
+            return {true, false, 0, _d};
+        }
+
+        static numeric_t normalize(const universal &_v) noexcept
+        {
+            switch (_v.get_type())
+            {
+            case universal::type_t::integer:
+                return {true, true, _v.to_int64_t(), 0};
+
+            case universal::type_t::floating:
+                return normalize(_v.to_double());
+
+            case universal::type_t::boolean:
+                return {true, true, _v.to_bool(), 0};
+
+            case universal::type_t::rgb24:
+                return {true, true, _v.to_rgb24_t().to_packed(), 0};
+
+            default:
+                return {false, false, 0, 0};
+            }
+        }
+
+        static bool equal(const numeric_t &_lhs, const numeric_t &_rhs) noexcept
+        {
+            if (!_lhs.valid || !_rhs.valid || _lhs.is_integer != _rhs.is_integer)
+                return false;
+            if (_lhs.is_integer)
+                return _lhs.integer == _rhs.integer;
+            return _lhs.floating == _rhs.floating;
+        }
+
+    public:
+        bool operator()(const universal &_lhs, int64_t _rhs) const noexcept
+        {
+            return equal(normalize(_lhs), {true, true, _rhs, 0});
+        }
+        bool operator()(const universal &_lhs, int _rhs) const noexcept
+        {
+            return (*this)(_lhs, (int64_t)_rhs);
+        }
+        bool operator()(const universal &_lhs, double _rhs) const noexcept
+        {
+            return equal(normalize(_lhs), normalize(_rhs));
+        }
+        bool operator()(const universal &_lhs, bool _rhs) const noexcept
+        {
+            return (*this)(_lhs, (int64_t)_rhs);
+        }
+        bool operator()(const universal &_lhs, const types::rgb24_t &_rhs) const noexcept
+        {
+            return (*this)(_lhs, (int64_t)_rhs.to_packed());
+        }
+        bool operator()(const universal &_lhs, std::string_view _rhs) const noexcept
+        {
+            return _lhs.get_type() == universal::type_t::string && std::string_view(_lhs.get_string()) == _rhs;
+        }
+        bool operator()(const universal &_lhs, const std::string &_rhs) const noexcept
+        {
+            return (*this)(_lhs, std::string_view(_rhs));
+        }
+        bool operator()(const universal &_lhs, const char *_rhs) const noexcept
+        {
+            return (*this)(_lhs, std::string_view(_rhs));
+        }
+        bool operator()(const universal &_lhs, const universal &_rhs) const noexcept
+        {
+            switch (_rhs.get_type())
+            {
+            case universal::type_t::string:
+                return (*this)(_lhs, std::string_view(_rhs.get_string()));
+
+            case universal::type_t::empty:
+                return _lhs.get_type() == universal::type_t::empty;
+
+            default:
+                return equal(normalize(_lhs), normalize(_rhs));
+            }
+        }
+
+        // reversed argument order as used by some container implementations
+        template<typename _K>
+        bool operator()(const _K &_lhs, const universal &_rhs) const noexcept
+        {
+            return (*this)(_rhs, _lhs);
+        }
+    };
+};
+
+#endif  // __EL_ENABLE_CXX17
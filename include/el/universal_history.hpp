@@ -0,0 +1,352 @@
+/*
+ELEKTRON © 2026 - now
+Written by melektron
+www.elektron.work
+16.10.26, 15:02
+All rights reserved.
+
+This source code is licensed under the Apache-2.0 license found in the
+LICENSE file in the root directory of this source tree.
+
+Fixed capacity time series history of el::universal values with incrementally
+maintained multi-resolution rollups (min, max, mean and last value per time bucket).
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <cstddef>
+#include <array>
+#include <limits>
+#include <utility>
+
+#include "cxxversions.h"
+#ifdef __EL_ENABLE_CXX17
+
+#include "universal.hpp"
+
+namespace el
+{
+    /**
+     * @brief Ring buffer of the most recent _N timestamped universal values.
+     *
+     * Samples must be appended in order of non-decreasing timestamps, which allows
+     * time range queries using binary search. When the buffer is full, the
+     * oldest sample is overwritten.
+     *
+     * In addition to the raw samples, the history keeps _Nlevels levels of rollups.
+     * Each level divides time into buckets of a fixed width (level 0: base width,
+     * every further level: previous width * level factor) and stores min, max,
+     * sum, count and last value (converted with universal::to_double()) of every bucket.
+     * The rollups are updated on every append in O(_Nlevels) and keep up to _Nbuckets
+     * buckets per level, so coarse levels cover a much longer period of time than
+     * the raw samples and zoomed-out views don't need to scan the raw data.
+     *
+     * @note All storage is part of the object, so large histories should not be
+     * placed on the stack.
+     *
+     * @tparam _N number of raw samples to keep
+     * @tparam _Nbuckets number of rollup buckets to keep per level
+     * @tparam _Nlevels number of rollup levels
+     */
+    template<std::size_t _N, std::size_t _Nbuckets = 256, std::size_t _Nlevels = 3>
+    class universal_history
+    {
+        static_assert(_N > 0, "universal_history needs room for at least one sample");
+        static_assert(_Nbuckets > 0, "universal_history needs room for at least one rollup bucket per level");
+
+    public:
+        using size_type = std::size_t;
+
+        struct sample_t
+        {
+            uint64_t timestamp = 0;
+            universal value;
+        };
+
+        struct rollup_t
+        {
+            uint64_t start = 0;     // timestamp of the start of the bucket
+            size_type count = 0;    // number of samples in the bucket
+            double min = 0;
+            double max = 0;
+            double sum = 0;
+            double last = 0;        // value of the newest sample in the bucket
+
+            double mean() const noexcept
+            {
+                return count ? sum / count : 0;
+            }
+        };
+
+    protected:
+        /**
+         * @brief fixed capacity ring of elements ordered from oldest to newest
+         */
+        template<typename _T, std::size_t _Nmax>
+        struct ring_t
+        {
+            static_assert(_Nmax > 0, "ring capacity must not be 0");
+
+            std::array<_T, _Nmax> items;
+            size_type head = 0;     // index of the oldest element
+            size_type count = 0;
+
+            _T &at(size_type _i) noexcept
+            {
+                return items[(head + _i) % _Nmax];
+            }
+            const _T &at(size_type _i) const noexcept
+            {
+                return items[(head + _i) % _Nmax];
+            }
+
+            // appends an element, overwriting the oldest one if full
+            _T &push() noexcept
+            {
+                if (count < _Nmax)
+                    return at(count++);
+                _T &slot = items[head];
+                head = (head + 1) % _Nmax;
+                return slot;
+            }
+        };
+
+        struct level_t
+        {
+            uint64_t width = 1;
+            ring_t<rollup_t, _Nbuckets> buckets;
+        };
+
+        ring_t<sample_t, _N> samples;
+        std::array<level_t, _Nlevels> levels;
+
+        /**
+         * @return the index of the first element in _ring for which _key(element) >= _ts
+         */
+        template<typename _Ring, typename _Key>
+        static size_type lower_bound_in(const _Ring &_ring, uint64_t _ts, _Key &&_key) noexcept
+        {
+            size_type lo = 0, hi = _ring.count;
+            while (lo < hi)
+            {
+                size_type mid = lo + (hi - lo) / 2;
+                if (_key(_ring.at(mid)) < _ts)
+                    lo = mid + 1;
+                else
+                    hi = mid;
+            }
+            return lo;
+        }
+
+        void update_rollups(uint64_t _ts, double _v) noexcept
+        {
+            for (level_t &level : levels)
+            {
+                uint64_t start = _ts - _ts % level.width;
+                rollup_t *bucket;
+                if (level.buckets.count == 0 || level.buckets.at(level.buckets.count - 1).start != start)
+                {
+                    bucket = &level.buckets.push();
+                    *bucket = rollup_t();
+                    bucket->start = start;
+                    bucket->min = _v;
+                    bucket->max = _v;
+                }
+                else
+                {
+                    bucket = &level.buckets.at(level.buckets.count - 1);
+                    if (_v < bucket->min)
+                        bucket->min = _v;
+                    if (_v > bucket->max)
+                        bucket->max = _v;
+                }
+                bucket->count++;
+                bucket->sum += _v;
+                bucket->last = _v;
+            }
+        }
+
+    public:
+        /**
+         * @param _base_width width of the rollup buckets in level 0 (in timestamp units)
+         * @param _level_factor factor by which the bucket width grows from one level to the next
+         */
+        universal_history(uint64_t _base_width, uint64_t _level_factor = 16)
+        {
+            uint64_t width = _base_width ? _base_width : 1;
+            for (level_t &level : levels)
+            {
+                level.width = width;
+                width *= _level_factor ? _level_factor : 1;
+            }
+        }
+
+        /**
+         * @brief appends a sample
+         *
+         * @param _ts timestamp of the sample. Must not be smaller than the timestamp of the newest sample.
+         * @param _value value of the sample
+         * @retval true sample was added
+         * @retval false the timestamp is older than the newest sample, nothing was added
+         */
+        bool append(uint64_t _ts, const universal &_value)
+        {
+            if (samples.count > 0 && _ts < newest().timestamp)
+                return false;
+            sample_t &s = samples.push();
+            s.timestamp = _ts;
+            s.value = _value;
+            update_rollups(_ts, _value.to_double());
+            return true;
+        }
+
+        /**
+         * @brief appends a sample using the timestamp stored in the universal value
+         */
+        bool append(const universal &_value)
+        {
+            return append(_value.get_timestamp(), _value);
+        }
+
+        /**
+         * @brief removes all samples and rollups
+         */
+        void clear() noexcept
+        {
+            samples.head = samples.count = 0;
+            for (level_t &level : levels)
+                level.buckets.head = level.buckets.count = 0;
+        }
+
+        // == raw samples == //
+
+        size_type size() const noexcept
+        {
+            return samples.count;
+        }
+
+        bool empty() const noexcept
+        {
+            return samples.count == 0;
+        }
+
+        static constexpr size_type capacity() noexcept
+        {
+            return _N;
+        }
+
+        /**
+         * @return the sample at index _i, where 0 is the oldest sample
+         */
+        const sample_t &operator[](size_type _i) const noexcept
+        {
+            return samples.at(_i);
+        }
+
+        const sample_t &oldest() const noexcept
+        {
+            return samples.at(0);
+        }
+
+        const sample_t &newest() const noexcept
+        {
+            return samples.at(samples.count - 1);
+        }
+
+        /**
+         * @return index of the first sample with a timestamp >= _ts (size() if there is none)
+         */
+        size_type lower_bound(uint64_t _ts) const noexcept
+        {
+            return lower_bound_in(samples, _ts, [](const sample_t &_s) { return _s.timestamp; });
+        }
+
+        /**
+         * @return the index range [first, second) of samples with timestamps in [_from, _to)
+         */
+        std::pair<size_type, size_type> range(uint64_t _from, uint64_t _to) const noexcept
+        {
+            size_type first = lower_bound(_from);
+            size_type last = _to > _from ? lower_bound(_to) : first;
+            return {first, last};
+        }
+
+        /**
+         * @brief calls _fn(const sample_t &) for every sample with a timestamp in [_from, _to)
+         */
+        template<typename _Fn>
+        void for_each(uint64_t _from, uint64_t _to, _Fn &&_fn) const
+        {
+            auto r = range(_from, _to);
+            for (size_type i = r.first; i < r.second; i++)
+                _fn(samples.at(i));
+        }
+
+        // == rollups == //
+
+        static constexpr size_type level_count() noexcept
+        {
+            return _Nlevels;
+        }
+
+        /**
+         * @return width of the buckets of a level in timestamp units
+         */
+        uint64_t level_width(size_type _level) const noexcept
+        {
+            return levels[_level].width;
+        }
+
+        /**
+         * @return number of buckets currently stored in a level
+         */
+        size_type bucket_count(size_type _level) const noexcept
+        {
+            return levels[_level].buckets.count;
+        }
+
+        /**
+         * @return bucket _i of a level, where 0 is the oldest bucket
+         */
+        const rollup_t &bucket(size_type _level, size_type _i) const noexcept
+        {
+            return levels[_level].buckets.at(_i);
+        }
+
+        /**
+         * @brief calls _fn(const rollup_t &) for every bucket of a level that overlaps
+         * with the time range [_from, _to)
+         */
+        template<typename _Fn>
+        void for_each_bucket(size_type _level, uint64_t _from, uint64_t _to, _Fn &&_fn) const
+        {
+            const level_t &level = levels[_level];
+            // first bucket that ends after _from
+            uint64_t first_start = _from - _from % level.width;
+            size_type i = lower_bound_in(level.buckets, first_start, [](const rollup_t &_b) { return _b.start; });
+            for (; i < level.buckets.count && level.buckets.at(i).start < _to; i++)
+                _fn(level.buckets.at(i));
+        }
+
+        /**
+         * @brief selects the finest level that represents the time range
+         * [_from, _to) with at most _max_points buckets. This is useful to
+         * pick the right resolution for a chart.
+         *
+         * @return level index, the coarsest level if no level is coarse enough
+         */
+        size_type select_level(uint64_t _from, uint64_t _to, size_type _max_points) const noexcept
+        {
+            uint64_t span = _to > _from ? _to - _from : 0;
+            for (size_type l = 0; l < _Nlevels; l++)
+            {
+                if (span / levels[l].width + 1 <= _max_points)
+                    return l;
+            }
+            return _Nlevels ? _Nlevels - 1 : 0;
+        }
+    };
+};
+
+#endif  // __EL_ENABLE_CXX17
@@ -0,0 +1,479 @@
+/*
+ELEKTRON © 2026 - now
+Written by melektron
+www.elektron.work
+16.10.26, 11:52
+All rights reserved.
+
+This source code is licensed under the Apache-2.0 license found in the
+LICENSE file in the root directory of this source tree.
+
+Flat open-addressing hash map using el::universal values as keys.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <utility>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+
+#include "cxxversions.h"
+#ifdef __EL_ENABLE_CXX17
+
+#include "universal.hpp"
+#include "detail/group_probe.hpp"
+#include "universal_hash.hpp"
+
+namespace el
+{
+    /**
+     * @brief Hash map with universal keys using flat open addressing.
+     *
+     * Slots are organized in groups of 16. For every slot there is one control
+     * byte which is either empty, deleted or holds 7 bits of the key's hash.
+     * Lookups compare the control bytes of an entire group at once (SSE2 if available)
+     * and only compare keys of slots with matching hash bits.
+     *
+     * Keys are hashed and compared using universal_hash and universal_key_equal,
+     * so lookups by int64_t, double, bool, rgb24_t and std::string_view are possible
+     * without creating a temporary universal object.
+     *
+     * @note Inserting into the map may rehash it, which invalidates all iterators and
+     * references to elements.
+     *
+     * @tparam _V mapped value type
+     */
+    template<typename _V>
+    class universal_map
+    {
+    public:
+        using key_type = universal;
+        using mapped_type = _V;
+        using value_type = std::pair<const universal, _V>;
+        using size_type = std::size_t;
+        using hasher = universal_hash;
+        using key_equal = universal_key_equal;
+
+    protected:
+        static constexpr size_type group_width = detail::group_width;
+        static constexpr int8_t ctrl_empty = detail::ctrl_empty;
+        static constexpr int8_t ctrl_deleted = detail::ctrl_deleted;
+
+        // control bytes, one per slot. Full slots store the lower 7 bits of the hash (>= 0).
+        int8_t *ctrl = nullptr;
+        // element storage, slots are only constructed if their control byte is >= 0
+        value_type *slots = nullptr;
+        // number of slots (power of two and multiple of group_width or 0)
+        size_type slot_count = 0;
+        // number of elements in the map
+        size_type element_count = 0;
+        // number of empty slots that can still be filled before the map needs to grow
+        size_type growth_left = 0;
+
+        /**
+         * @brief searches the slot holding a key
+         *
+         * @return index of the slot or slot_count if not found
+         */
+        template<typename _K>
+        size_type find_slot(const _K &_key, size_t _hash) const noexcept
+        {
+            return detail::find_slot(ctrl, slot_count, _hash, [&](size_type _index) {
+                return key_equal()(slots[_index].first, _key);
+            });
+        }
+
+        /**
+         * @brief finds the first empty or deleted slot in the probe sequence of a hash.
+         * The map must not be full.
+         */
+        size_type find_free_slot(size_t _hash) const noexcept
+        {
+            return detail::find_free_slot(ctrl, slot_count, _hash);
+        }
+
+        /**
+         * @brief allocates a new table with _new_slot_count slots and moves all elements into it.
+         * The new table is built separately and only swapped in once all elements are in it,
+         * so if copying a key throws, the map is left unchanged.
+         */
+        void rehash_to(size_type _new_slot_count)
+        {
+            // values are only moved if they can be moved back when a later key copy throws
+            constexpr bool move_values = std::is_nothrow_move_constructible_v<_V> && std::is_nothrow_move_assignable_v<_V>;
+
+            universal_map table;
+            table.ctrl = new int8_t[_new_slot_count];
+            std::memset(table.ctrl, ctrl_empty, _new_slot_count);
+            table.slots = std::allocator<value_type>().allocate(_new_slot_count);
+            table.slot_count = _new_slot_count;
+            table.growth_left = _new_slot_count - _new_slot_count / 8;
+
+            // moves the values back into this map if not all elements made it into the table
+            struct rollback_t
+            {
+                universal_map &map;
+                universal_map &table;
+                bool done = false;
+
+                ~rollback_t()
+                {
+                    if constexpr (move_values)
+                    {
+                        if (done)
+                            return;
+                        for (size_type i = 0; i < map.slot_count; i++)
+                        {
+                            if (map.ctrl[i] < 0)
+                                continue;
+                            size_type index = table.find_slot(map.slots[i].first, hasher()(map.slots[i].first));
+                            if (index != table.slot_count)
+                                map.slots[i].second = std::move(table.slots[index].second);
+                        }
+                    }
+                }
+            } rollback{*this, table};
+
+            for (size_type i = 0; i < slot_count; i++)
+            {
+                if (ctrl[i] < 0)
+                    continue;
+                size_t hash = hasher()(slots[i].first);
+                size_type index = table.find_free_slot(hash);
+                // the key is const and therefore always copied
+                if constexpr (move_values)
+                    new (table.slots + index) value_type(slots[i].first, std::move(slots[i].second));
+                else
+                    new (table.slots + index) value_type(slots[i]);
+                table.ctrl[index] = detail::h2(hash);
+                table.growth_left--;
+                table.element_count++;
+            }
+            rollback.done = true;
+
+            // the old table with the moved-from elements is released by table's destructor
+            swap(table);
+        }
+
+        /**
+         * @brief makes space for at least one more element, either by growing
+         * the table or by rehashing in place to remove deleted slots.
+         */
+        void prepare_insert()
+        {
+            if (growth_left > 0)
+                return;
+            if (slot_count == 0)
+                rehash_to(group_width);
+            else if (element_count * 2 < slot_count - slot_count / 8)
+                rehash_to(slot_count);  // mostly deleted slots, clean them up
+            else
+                rehash_to(slot_count * 2);
+        }
+
+        void destroy_all() noexcept
+        {
+            for (size_type i = 0; i < slot_count; i++)
+            {
+                if (ctrl[i] >= 0)
+                    slots[i].~value_type();
+            }
+        }
+
+        void release() noexcept
+        {
+            // ctrl can exist without slots if allocating a table failed half way
+            if (slot_count != 0)
+            {
+                destroy_all();
+                std::allocator<value_type>().deallocate(slots, slot_count);
+            }
+            delete[] ctrl;
+            ctrl = nullptr;
+            slots = nullptr;
+            slot_count = 0;
+            element_count = 0;
+            growth_left = 0;
+        }
+
+    public:
+        /**
+         * @brief forward iterator over all elements of the map
+         */
+        template<bool _Const>
+        class iterator_base
+        {
+            friend class universal_map;
+            template<bool _OConst>
+            friend class iterator_base;
+            using map_ptr_t = std::conditional_t<_Const, const universal_map *, universal_map *>;
+
+            map_ptr_t map;
+            size_type index;
+
+            iterator_base(map_ptr_t _map, size_type _index) noexcept
+                : map(_map)
+                , index(_index)
+            {
+                skip_free();
+            }
+
+            void skip_free() noexcept
+            {
+                while (index < map->slot_count && map->ctrl[index] < 0)
+                    index++;
+            }
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = universal_map::value_type;
+            using difference_type = std::ptrdiff_t;
+            using pointer = std::conditional_t<_Const, const value_type *, value_type *>;
+            using reference = std::conditional_t<_Const, const value_type &, value_type &>;
+
+            iterator_base() = default;
+
+            // allow conversion from mutable to const iterator
+            template<bool _OConst, typename = std::enable_if_t<_Const && !_OConst>>
+            iterator_base(const iterator_base<_OConst> &_other) noexcept
+                : map(_other.map)
+                , index(_other.index)
+            {}
+
+            reference operator*() const noexcept
+            {
+                return map->slots[index];
+            }
+            pointer operator->() const noexcept
+            {
+                return map->slots + index;
+            }
+            iterator_base &operator++() noexcept
+            {
+                index++;
+                skip_free();
+                return *this;
+            }
+            iterator_base operator++(int) noexcept
+            {
+                iterator_base old = *this;
+                ++(*this);
+                return old;
+            }
+            friend bool operator==(const iterator_base &_lhs, const iterator_base &_rhs) noexcept
+            {
+                return _lhs.index == _rhs.index;
+            }
+            friend bool operator!=(const iterator_base &_lhs, const iterator_base &_rhs) noexcept
+            {
+                return _lhs.index != _rhs.index;
+            }
+        };
+
+        using iterator = iterator_base<false>;
+        using const_iterator = iterator_base<true>;
+
+        universal_map() = default;
+
+        // delegating to the default constructor makes the destructor clean up if a copy throws
+        universal_map(const universal_map &_other)
+            : universal_map()
+        {
+            reserve(_other.size());
+            for (const auto &item : _other)
+                try_emplace(item.first, item.second);
+        }
+
+        universal_map(universal_map &&_other) noexcept
+            : ctrl(_other.ctrl)
+            , slots(_other.slots)
+            , slot_count(_other.slot_count)
+            , element_count(_other.element_count)
+            , growth_left(_other.growth_left)
+        {
+            _other.ctrl = nullptr;
+            _other.slots = nullptr;
+            _other.slot_count = 0;
+            _other.element_count = 0;
+            _other.growth_left = 0;
+        }
+
+        universal_map &operator=(const universal_map &_other)
+        {
+            if (this != &_other)
+            {
+                universal_map copy(_other);
+                swap(copy);
+            }
+            return *this;
+        }
+
+        universal_map &operator=(universal_map &&_other) noexcept
+        {
+            if (this != &_other)
+            {
+                release();
+                swap(_other);
+            }
+            return *this;
+        }
+
+        ~universal_map()
+        {
+            release();
+        }
+
+        void swap(universal_map &_other) noexcept
+        {
+            std::swap(ctrl, _other.ctrl);
+            std::swap(slots, _other.slots);
+            std::swap(slot_count, _other.slot_count);
+            std::swap(element_count, _other.element_count);
+            std::swap(growth_left, _other.growth_left);
+        }
+
+        iterator begin() noexcept { return iterator(this, 0); }
+        iterator end() noexcept { return iterator(this, slot_count); }
+        const_iterator begin() const noexcept { return const_iterator(this, 0); }
+        const_iterator end() const noexcept { return const_iterator(this, slot_count); }
+
+        /**
+         * @return the amount of elements in the map
+         */
+        size_type size() const noexcept
+        {
+            return element_count;
+        }
+
+        /**
+         * @return true if there are no elements in the map
+         */
+        bool empty() const noexcept
+        {
+            return element_count == 0;
+        }
+
+        /**
+         * @brief destroys all elements. The allocated table is kept.
+         */
+        void clear() noexcept
+        {
+            if (slot_count == 0)
+                return;
+            destroy_all();
+            std::memset(ctrl, ctrl_empty, slot_count);
+            element_count = 0;
+            growth_left = slot_count - slot_count / 8;
+        }
+
+        /**
+         * @brief allocates space so that _n elements can be stored without rehashing
+         */
+        void reserve(size_type _n)
+        {
+            size_type needed = group_width;
+            while (needed - needed / 8 < _n)
+                needed *= 2;
+            if (needed > slot_count)
+                rehash_to(needed);
+        }
+
+        /**
+         * @brief looks up a key
+         *
+         * @tparam _K key type (universal or any raw type supported by universal_hash)
+         * @param _key the key to search for
+         * @return iterator to the element or end() if not found
+         */
+        template<typename _K>
+        iterator find(const _K &_key) noexcept
+        {
+            return iterator(this, find_slot(_key, hasher()(_key)));
+        }
+        template<typename _K>
+        const_iterator find(const _K &_key) const noexcept
+        {
+            return const_iterator(this, find_slot(_key, hasher()(_key)));
+        }
+
+        /**
+         * @return true if the map contains an element with a key equal to _key
+         */
+        template<typename _K>
+        bool contains(const _K &_key) const noexcept
+        {
+            return find_slot(_key, hasher()(_key)) != slot_count;
+        }
+
+        /**
+         * @brief inserts a new element with value constructed from _args
+         * if there is no element with an equal key yet.
+         *
+         * @return pair of iterator to the element with the key and bool
+         * which is true if the element was inserted.
+         */
+        template<typename... _Args>
+        std::pair<iterator, bool> try_emplace(const universal &_key, _Args&&... _args)
+        {
+            size_t hash = hasher()(_key);
+            size_type index = find_slot(_key, hash);
+            if (index != slot_count)
+                return {iterator(this, index), false};
+
+            prepare_insert();
+            index = find_free_slot(hash);
+            new (slots + index) value_type(
+                std::piecewise_construct,
+                std::forward_as_tuple(_key),
+                std::forward_as_tuple(std::forward<_Args>(_args)...)
+            );
+            // only publish the slot once the element exists
+            if (ctrl[index] == ctrl_empty)
+                growth_left--;
+            ctrl[index] = detail::h2(hash);
+            element_count++;
+            return {iterator(this, index), true};
+        }
+
+        /**
+         * @brief inserts a copy of _value if there is no element with an equal key yet.
+         */
+        std::pair<iterator, bool> insert(const value_type &_value)
+        {
+            return try_emplace(_value.first, _value.second);
+        }
+
+        /**
+         * @return reference to the value mapped to _key, which is
+         * default constructed and inserted if it didn't exist yet.
+         */
+        _V &operator[](const universal &_key)
+        {
+            return try_emplace(_key).first->second;
+        }
+
+        /**
+         * @brief removes the element with a key equal to _key if it exists
+         *
+         * @return number of removed elements (0 or 1)
+         */
+        template<typename _K>
+        size_type erase(const _K &_key)
+        {
+            size_type index = find_slot(_key, hasher()(_key));
+            if (index == slot_count)
+                return 0;
+            slots[index].~value_type();
+            ctrl[index] = ctrl_deleted;
+            element_count--;
+            return 1;
+        }
+    };
+};
+
+#endif  // __EL_ENABLE_CXX17
@@ -0,0 +1,900 @@
+/*
+ELEKTRON © 2026 - now
+Written by melektron
+www.elektron.work
+16.10.26, 18:05
+All rights reserved.
+
+This source code is licensed under the Apache-2.0 license found in the
+LICENSE file in the root directory of this source tree.
+
+Compiled filter expressions over el::universal values.
+
+An expression is parsed once, constant-folded and translated into a flat
+bytecode program which is then evaluated for every value. Comparisons use
+exactly the same semantics as the comparison operators of universal.
+
+Expression language:
+    expr       := or
+    or         := and { ("or" | "||") and }
+    and        := unary { ("and" | "&&") unary }
+    unary      := ("not" | "!") unary | primary
+    primary    := "(" expr ")" | operand [ compare operand ]
+    compare    := "==" | "!=" | "<" | "<=" | ">" | ">="
+    operand    := "value" | "unit" | "timestamp" | literal
+    literal    := integer | floating | "true" | "false" | "empty"
+                | 'string' | "string" | #rrggbb
+
+"value" is the universal itself, "unit" its unit (as string) and "timestamp"
+its timestamp (as integer). An operand without comparison is converted to bool
+using universal::to_bool().
+
+Example: value > 30 and unit == 'C'
+
+Nesting of parentheses and "not" as well as the length of an expression are
+limited (see universal_predicate::max_nesting and max_nodes), so expressions
+from untrusted sources can be compiled without risking a stack overflow.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <utility>
+
+#include "cxxversions.h"
+#ifdef __EL_ENABLE_CXX17
+
+#include <string_view>
+
+#ifdef __EL_ENABLE_CXX20
+#include <span>
+#endif
+
+#include "universal.hpp"
+#include "types.hpp"
+#include "retcode.hpp"
+
+namespace el
+{
+    /**
+     * @brief Filter expression compiled to bytecode and evaluated against universal values.
+     * See universal_predicate.hpp for the expression language.
+     *
+     * Comparisons of "value" with a literal are specialized on the type of the literal
+     * at compile time, so evaluating them calls the raw type comparison operator of
+     * universal directly. Sub-expressions consisting only of literals are evaluated at
+     * compile time and "not" is folded into the comparisons.
+     */
+    class universal_predicate
+    {
+    public:
+        // maximum nesting depth of the evaluation stack
+        static constexpr size_t max_depth = 64;
+        // maximum nesting of parentheses and "not" in the source
+        static constexpr size_t max_nesting = 256;
+        // maximum number of operations in an expression (before folding)
+        static constexpr size_t max_nodes = 4096;
+
+    protected:
+        enum class operand_t : uint8_t
+        {
+            value,
+            unit,
+            timestamp,
+            constant,
+        };
+
+        enum class opcode_t : uint8_t
+        {
+            push_true,
+            push_false,
+            // value compared to a literal, specialized on the literal type
+            value_eq_int,
+            value_eq_double,
+            value_eq_bool,
+            value_eq_rgb,
+            value_eq_string,
+            value_is_empty,
+            value_lt_int,
+            value_lt_double,
+            value_lt_bool,
+            value_lt_rgb,
+            value_truth,
+            unit_eq_string,
+            // any operands, compared using universal operators
+            generic_eq,
+            generic_lt,
+            generic_truth,
+            // logic
+            logic_and,
+            logic_or,
+            logic_not,
+        };
+
+        struct instruction_t
+        {
+            opcode_t op = opcode_t::push_false;
+            bool negate = false;
+            operand_t lhs = operand_t::value;
+            operand_t rhs = operand_t::value;
+            uint32_t lhs_index = 0;     // constant pool index if lhs is a constant
+            uint32_t rhs_index = 0;     // constant pool index if rhs is a constant
+            int64_t integer = 0;
+            double floating = 0;
+            types::rgb24_t rgb24;
+        };
+
+        // == parse tree == //
+
+        enum class node_kind_t : uint8_t
+        {
+            constant,   // constant boolean result
+            compare,    // comparison or truth test of operands
+            logic_not,
+            logic_and,
+            logic_or,
+        };
+
+        enum class relation_t : uint8_t
+        {
+            eq,         // lhs == rhs
+            lt,         // lhs < rhs
+            truth,      // lhs.to_bool()
+        };
+
+        struct node_t
+        {
+            node_kind_t kind = node_kind_t::constant;
+            bool result = false;        // constant
+            relation_t relation = relation_t::truth;
+            bool negate = false;        // compare: result is inverted
+            operand_t lhs = operand_t::value;
+            operand_t rhs = operand_t::value;
+            uint32_t lhs_index = 0;
+            uint32_t rhs_index = 0;
+            uint32_t a = 0;             // child nodes
+            uint32_t b = 0;
+        };
+
+        std::vector<instruction_t> program;
+        std::vector<universal> constants;
+        std::vector<node_t> nodes;
+        std::string error_text;
+        size_t error_offset = 0;
+
+        // == tokenizer and parser == //
+
+        std::string_view source;
+        size_t position = 0;
+        size_t nesting = 0;
+
+        void skip_space() noexcept
+        {
+            while (position < source.size() && (source[position] == ' ' || source[position] == '\t' || source[position] == '\n' || source[position] == '\r'))
+                position++;
+        }
+
+        static bool is_ident_char(char _c) noexcept
+        {
+            return (_c >= 'a' && _c <= 'z') || (_c >= 'A' && _c <= 'Z') || (_c >= '0' && _c <= '9') || _c == '_';
+        }
+
+        /**
+         * @brief consumes _token if it is next in the input. Word tokens
+         * must not be followed by another identifier character.
+         */
+        bool accept(std::string_view _token) noexcept
+        {
+            skip_space();
+            if (source.substr(position, _token.size()) != _token)
+                return false;
+            size_t end = position + _token.size();
+            if (is_ident_char(_token.back()) && end < source.size() && is_ident_char(source[end]))
+                return false;
+            position = end;
+            return true;
+        }
+
+        bool fail(const char *_message)
+        {
+            if (error_text.empty())
+            {
+                error_text = _message;
+                error_offset = position;
+            }
+            return false;
+        }
+
+        uint32_t add_node(const node_t &_node)
+        {
+            nodes.push_back(_node);
+            return (uint32_t)nodes.size() - 1;
+        }
+
+        uint32_t add_constant(universal &&_value)
+        {
+            constants.push_back(std::move(_value));
+            return (uint32_t)constants.size() - 1;
+        }
+
+        bool parse_string_literal(universal &_out)
+        {
+            char quote = source[position++];
+            std::string text;
+            while (position < source.size() && source[position] != quote)
+            {
+                if (source[position] == '\\' && position + 1 < source.size())
+                    position++;
+                text += source[position++];
+            }
+            if (position >= source.size())
+                return fail("unterminated string literal");
+            position++;
+            _out = std::move(text);
+            return true;
+        }
+
+        bool parse_number_literal(universal &_out)
+        {
+            size_t start = position;
+            bool is_float = false;
+            if (source[position] == '-' || source[position] == '+')
+                position++;
+            while (position < source.size())
+            {
+                char c = source[position];
+                if (c >= '0' && c <= '9')
+                    position++;
+                else if (c == '.' || c == 'e' || c == 'E')
+                {
+                    is_float = true;
+                    position++;
+                    if ((c == 'e' || c == 'E') && position < source.size() && (source[position] == '-' || source[position] == '+'))
+                        position++;
+                }
+                else
+                    break;
+            }
+
+            std::string text(source.substr(start, position - start));
+            char *end = nullptr;
+            if (is_float)
+                _out = std::strtod(text.c_str(), &end);
+            else
+                _out = (int64_t)std::strtoll(text.c_str(), &end, 10);
+            if (end != text.c_str() + text.size() || text.empty())
+            {
+                position = start;
+                return fail("invalid number");
+            }
+            return true;
+        }
+
+        bool parse_operand(operand_t &_kind, uint32_t &_index)
+        {
+            skip_space();
+            if (position >= source.size())
+                return fail("operand expected");
+
+            universal literal;
+            char c = source[position];
+            if (accept("value"))
+            {
+                _kind = operand_t::value;
+                return true;
+            }
+            else if (accept("unit"))
+            {
+                _kind = operand_t::unit;
+                return true;
+            }
+            else if (accept("timestamp"))
+            {
+                _kind = operand_t::timestamp;
+                return true;
+            }
+            else if (accept("true"))
+                literal = true;
+            else if (accept("false"))
+                literal = false;
+            else if (accept("empty"))
+                literal.clear();
+            else if (c == '\'' || c == '"')
+            {
+                if (!parse_string_literal(literal))
+                    return false;
+            }
+            else if (c == '#')
+            {
+                size_t start = ++position;
+                while (position < source.size() && is_ident_char(source[position]))
+                    position++;
+                std::string hex(source.substr(start, position - start));
+                char *end = nullptr;
+                unsigned long packed = std::strtoul(hex.c_str(), &end, 16);
+                if (hex.size() != 6 || end != hex.c_str() + hex.size())
+                {
+                    position = start - 1;
+                    return fail("invalid color, expected #rrggbb");
+                }
+                literal = types::rgb24_t((uint32_t)packed);
+            }
+            else if ((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.')
+            {
+                if (!parse_number_literal(literal))
+                    return false;
+            }
+            else
+                return fail("operand expected");
+
+            _kind = operand_t::constant;
+            _index = add_constant(std::move(literal));
+            return true;
+        }
+
+        bool parse_primary(uint32_t &_out)
+        {
+            if (accept("("))
+            {
+                if (!parse_or(_out))
+                    return false;
+                if (!accept(")"))
+                    return fail("')' expected");
+                return true;
+            }
+
+            node_t node;
+            node.kind = node_kind_t::compare;
+            if (!parse_operand(node.lhs, node.lhs_index))
+                return false;
+
+            // a <= b is !(b < a) and a >= b is !(a < b), like in universal
+            bool swap = false;
+            if (accept("=="))
+                node.relation = relation_t::eq;
+            else if (accept("!="))
+                node.relation = relation_t::eq, node.negate = true;
+            else if (accept("<="))
+                node.relation = relation_t::lt, node.negate = true, swap = true;
+            else if (accept(">="))
+                node.relation = relation_t::lt, node.negate = true;
+            else if (accept("<"))
+                node.relation = relation_t::lt;
+            else if (accept(">"))
+                node.relation = relation_t::lt, swap = true;
+            else
+                node.relation = relation_t::truth;
+
+            if (node.relation != relation_t::truth)
+            {
+                if (!parse_operand(node.rhs, node.rhs_index))
+                    return false;
+                if (swap)
+                {
+                    std::swap(node.lhs, node.rhs);
+                    std::swap(node.lhs_index, node.rhs_index);
+                }
+            }
+            _out = add_node(node);
+            return true;
+        }
+
+        bool parse_unary(uint32_t &_out)
+        {
+            // every operand passes through here, so this bounds the recursion of the
+            // parser as well as of fold() and emit() for untrusted input
+            if (nesting >= max_nesting)
+                return fail("expression nested too deeply");
+            if (nodes.size() >= max_nodes)
+                return fail("expression too long");
+
+            nesting++;
+            bool ok;
+            if (accept("not") || accept("!"))
+            {
+                node_t node;
+                node.kind = node_kind_t::logic_not;
+                ok = parse_unary(node.a);
+                if (ok)
+                    _out = add_node(node);
+            }
+            else
+            {
+                ok = parse_primary(_out);
+            }
+            nesting--;
+            return ok;
+        }
+
+        bool parse_and(uint32_t &_out)
+        {
+            if (!parse_unary(_out))
+                return false;
+            while (accept("and") || accept("&&"))
+            {
+                node_t node;
+                node.kind = node_kind_t::logic_and;
+                node.a = _out;
+                if (!parse_unary(node.b))
+                    return false;
+                _out = add_node(node);
+            }
+            return true;
+        }
+
+        bool parse_or(uint32_t &_out)
+        {
+            if (!parse_and(_out))
+                return false;
+            while (accept("or") || accept("||"))
+            {
+                node_t node;
+                node.kind = node_kind_t::logic_or;
+                node.a = _out;
+                if (!parse_and(node.b))
+                    return false;
+                _out = add_node(node);
+            }
+            return true;
+        }
+
+        // == constant folding == //
+
+        static node_t constant_node(bool _result) noexcept
+        {
+            node_t node;
+            node.kind = node_kind_t::constant;
+            node.result = _result;
+            return node;
+        }
+
+        /**
+         * @brief simplifies the tree below node _n in place
+         */
+        void fold(uint32_t _n)
+        {
+            node_t &node = nodes[_n];
+            switch (node.kind)
+            {
+            case node_kind_t::compare:
+            {
+                bool lhs_const = node.lhs == operand_t::constant;
+                bool rhs_const = node.relation == relation_t::truth || node.rhs == operand_t::constant;
+                if (lhs_const && rhs_const)
+                {
+                    const universal &lhs = constants[node.lhs_index];
+                    bool r;
+                    if (node.relation == relation_t::truth)
+                        r = lhs.to_bool();
+                    else if (node.relation == relation_t::eq)
+                        r = lhs == constants[node.rhs_index];
+                    else
+                        r = lhs < constants[node.rhs_index];
+                    nodes[_n] = constant_node(r != node.negate);
+                }
+                else if (node.relation == relation_t::eq
+                    && ((node.lhs == operand_t::unit && rhs_const && constants[node.rhs_index].get_type() != universal_type_t::string)
+                    || (node.rhs == operand_t::unit && lhs_const && constants[node.lhs_index].get_type() != universal_type_t::string)))
+                {
+                    // the unit is a string and strings are never equal to other types
+                    nodes[_n] = constant_node(node.negate);
+                }
+                break;
+            }
+
+            case node_kind_t::logic_not:
+            {
+                fold(node.a);
+                node_t child = nodes[nodes[_n].a];
+                if (child.kind == node_kind_t::constant)
+                    nodes[_n] = constant_node(!child.result);
+                else if (child.kind == node_kind_t::compare)
+                {
+                    child.negate = !child.negate;
+                    nodes[_n] = child;
+                }
+                else if (child.kind == node_kind_t::logic_not)
+                    nodes[_n] = nodes[child.a];
+                break;
+            }
+
+            case node_kind_t::logic_and:
+            case node_kind_t::logic_or:
+            {
+                fold(node.a);
+                fold(nodes[_n].b);
+                bool is_and = nodes[_n].kind == node_kind_t::logic_and;
+                node_t a = nodes[nodes[_n].a];
+                node_t b = nodes[nodes[_n].b];
+                // x and false = false, x and true = x, x or true = true, x or false = x
+                if (a.kind == node_kind_t::constant)
+                    nodes[_n] = (a.result != is_and) ? constant_node(a.result) : b;
+                else if (b.kind == node_kind_t::constant)
+                    nodes[_n] = (b.result != is_and) ? constant_node(b.result) : a;
+                break;
+            }
+
+            default:
+                break;
+            }
+        }
+
+        // == code generation == //
+
+        /**
+         * @brief creates the instruction for a comparison node, specialized
+         * on the type of the literal if possible
+         */
+        instruction_t compile_compare(const node_t &_node) const
+        {
+            instruction_t ins;
+            ins.negate = _node.negate;
+            ins.lhs = _node.lhs;
+            ins.rhs = _node.rhs;
+            ins.lhs_index = _node.lhs_index;
+            ins.rhs_index = _node.rhs_index;
+
+            if (_node.relation == relation_t::truth)
+            {
+                ins.op = _node.lhs == operand_t::value ? opcode_t::value_truth : opcode_t::generic_truth;
+                return ins;
+            }
+
+            ins.op = _node.relation == relation_t::eq ? opcode_t::generic_eq : opcode_t::generic_lt;
+            if (_node.rhs != operand_t::constant || (_node.lhs != operand_t::value && _node.lhs != operand_t::unit))
+                return ins;
+
+            // lhs is value or unit and rhs is a literal: universal dispatches on the
+            // type of rhs and calls the raw type operator, so do this right away.
+            const universal &c = constants[_node.rhs_index];
+            if (_node.lhs == operand_t::unit)
+            {
+                // non-string literals were already folded
+                if (_node.relation == relation_t::eq)
+                    ins.op = opcode_t::unit_eq_string;
+                return ins;
+            }
+
+            bool eq = _node.relation == relation_t::eq;
+            switch (c.get_type())
+            {
+            case universal_type_t::integer:
+                ins.op = eq ? opcode_t::value_eq_int : opcode_t::value_lt_int;
+                ins.integer = c.to_int64_t();
+                break;
+
+            case universal_type_t::floating:
+                ins.op = eq ? opcode_t::value_eq_double : opcode_t::value_lt_double;
+                ins.floating = c.to_double();
+                break;
+
+            case universal_type_t::boolean:
+                ins.op = eq ? opcode_t::value_eq_bool : opcode_t::value_lt_bool;
+                ins.integer = c.to_bool();
+                break;
+
+            case universal_type_t::rgb24:
+                ins.op = eq ? opcode_t::value_eq_rgb : opcode_t::value_lt_rgb;
+                ins.rgb24 = c.to_rgb24_t();
+                break;
+
+            case universal_type_t::string:
+                // less than compares to the length of the string
+                ins.op = eq ? opcode_t::value_eq_string : opcode_t::value_lt_int;
+                ins.integer = c.get_string().length();
+                break;
+
+            case universal_type_t::empty:
+                // both == and < return true if lhs is empty as well
+                ins.op = opcode_t::value_is_empty;
+                break;
+
+            default:
+                break;
+            }
+            return ins;
+        }
+
+        /**
+         * @brief appends the program for node _n in postfix order
+         *
+         * @return maximum stack depth needed by the program of the node
+         */
+        size_t emit(uint32_t _n)
+        {
+            node_t node = nodes[_n];
+            switch (node.kind)
+            {
+            case node_kind_t::constant:
+            {
+                instruction_t ins;
+                ins.op = node.result ? opcode_t::push_true : opcode_t::push_false;
+                program.push_back(ins);
+                return 1;
+            }
+
+            case node_kind_t::compare:
+                program.push_back(compile_compare(node));
+                return 1;
+
+            case node_kind_t::logic_not:
+            {
+                size_t depth = emit(node.a);
+                instruction_t ins;
+                ins.op = opcode_t::logic_not;
+                program.push_back(ins);
+                return depth;
+            }
+
+            case node_kind_t::logic_and:
+            case node_kind_t::logic_or:
+            {
+                size_t depth_a = emit(node.a);
+                size_t depth_b = emit(node.b) + 1;
+                instruction_t ins;
+                ins.op = node.kind == node_kind_t::logic_and ? opcode_t::logic_and : opcode_t::logic_or;
+                program.push_back(ins);
+                return depth_a > depth_b ? depth_a : depth_b;
+            }
+
+            default:
+                return 0;
+            }
+        }
+
+        // == evaluation == //
+
+        /**
+         * @return the universal object an operand refers to. Unit and timestamp
+         * are stored in _tmp.
+         */
+        const universal &resolve(operand_t _kind, uint32_t _index, const universal &_value, universal &_tmp) const
+        {
+            switch (_kind)
+            {
+            case operand_t::unit:
+                _tmp = _value.get_unit();
+                return _tmp;
+
+            case operand_t::timestamp:
+                _tmp = (int64_t)_value.get_timestamp();
+                return _tmp;
+
+            case operand_t::constant:
+                return constants[_index];
+
+            case operand_t::value:
+            default:
+                return _value;
+            }
+        }
+
+        /**
+         * @brief evaluates a single comparison instruction
+         */
+        bool evaluate_compare(const instruction_t &_ins, const universal &_value) const
+        {
+            bool r;
+            switch (_ins.op)
+            {
+            case opcode_t::value_eq_int: r = _value == _ins.integer; break;
+            case opcode_t::value_eq_double: r = _value == _ins.floating; break;
+            case opcode_t::value_eq_bool: r = _value == (bool)_ins.integer; break;
+            case opcode_t::value_eq_rgb: r = _value == _ins.rgb24; break;
+            case opcode_t::value_eq_string: r = _value == std::string_view(constants[_ins.rhs_index].get_string()); break;
+            case opcode_t::value_is_empty: r = _value.get_type() == universal_type_t::empty; break;
+            case opcode_t::value_lt_int: r = _value < _ins.integer; break;
+            case opcode_t::value_lt_double: r = _value < _ins.floating; break;
+            case opcode_t::value_lt_bool: r = _value < (bool)_ins.integer; break;
+            case opcode_t::value_lt_rgb: r = _value < _ins.rgb24; break;
+            case opcode_t::value_truth: r = _value.to_bool(); break;
+            case opcode_t::unit_eq_string: r = _value.get_unit() == constants[_ins.rhs_index].get_string(); break;
+
+            case opcode_t::generic_eq:
+            case opcode_t::generic_lt:
+            {
+                universal lhs_tmp, rhs_tmp;
+                const universal &lhs = resolve(_ins.lhs, _ins.lhs_index, _value, lhs_tmp);
+                const universal &rhs = resolve(_ins.rhs, _ins.rhs_index, _value, rhs_tmp);
+                r = _ins.op == opcode_t::generic_eq ? lhs == rhs : lhs < rhs;
+                break;
+            }
+
+            case opcode_t::generic_truth:
+            {
+                universal tmp;
+                r = resolve(_ins.lhs, _ins.lhs_index, _value, tmp).to_bool();
+                break;
+            }
+
+            case opcode_t::push_true: r = true; break;
+            default: r = false; break;
+            }
+            return r != _ins.negate;
+        }
+
+    public:
+        universal_predicate() = default;
+
+        /**
+         * @brief compiles an expression. Use valid() or error() to check the result.
+         */
+        explicit universal_predicate(std::string_view _expression)
+        {
+            compile(_expression);
+        }
+
+        /**
+         * @brief compiles an expression, replacing the current program
+         *
+         * @param _expression expression source (see universal_predicate.hpp)
+         * @retval retcode::ok the expression was compiled
+         * @retval retcode::invalid syntax error, see error() and error_position().
+         * The predicate evaluates to false in this case.
+         */
+        retcode compile(std::string_view _expression)
+        {
+            program.clear();
+            constants.clear();
+            nodes.clear();
+            error_text.clear();
+            error_offset = 0;
+            source = _expression;
+            position = 0;
+            nesting = 0;
+
+            uint32_t root;
+            bool ok = parse_or(root);
+            skip_space();
+            if (ok && position != source.size())
+                ok = fail("unexpected input");
+
+            if (ok)
+            {
+                fold(root);
+                size_t depth = emit(root);
+                if (depth > max_depth)
+                {
+                    program.clear();
+                    error_offset = 0;
+                    ok = fail("expression nested too deeply");
+                }
+            }
+
+            if (!ok)
+            {
+                program.clear();
+                instruction_t ins;
+                ins.op = opcode_t::push_false;
+                program.push_back(ins);
+            }
+
+            nodes.clear();
+            nodes.shrink_to_fit();
+            source = std::string_view();
+            return ok ? retcode::ok : retcode::invalid;
+        }
+
+        /**
+         * @return true if the last compiled expression was valid
+         */
+        bool valid() const noexcept
+        {
+            return error_text.empty() && !program.empty();
+        }
+
+        /**
+         * @return description of the syntax error or an empty string
+         */
+        const std::string &error() const noexcept
+        {
+            return error_text;
+        }
+
+        /**
+         * @return offset of the syntax error in the expression
+         */
+        size_t error_position() const noexcept
+        {
+            return error_offset;
+        }
+
+        /**
+         * @return number of bytecode instructions (after constant folding)
+         */
+        size_t instruction_count() const noexcept
+        {
+            return program.size();
+        }
+
+        /**
+         * @brief evaluates the predicate for a single value
+         */
+        bool evaluate(const universal &_value) const
+        {
+            // default constructed, nothing compiled yet
+            if (program.empty())
+                return false;
+            if (program.size() == 1)
+                return evaluate_compare(program[0], _value);
+
+            bool stack[max_depth];
+            size_t sp = 0;
+            for (const instruction_t &ins : program)
+            {
+                switch (ins.op)
+                {
+                case opcode_t::logic_and:
+                    sp--;
+                    stack[sp - 1] = stack[sp - 1] && stack[sp];
+                    break;
+
+                case opcode_t::logic_or:
+                    sp--;
+                    stack[sp - 1] = stack[sp - 1] || stack[sp];
+                    break;
+
+                case opcode_t::logic_not:
+                    stack[sp - 1] = !stack[sp - 1];
+                    break;
+
+                default:
+                    stack[sp++] = evaluate_compare(ins, _value);
+                    break;
+                }
+            }
+            return stack[0];
+        }
+
+        bool operator()(const universal &_value) const
+        {
+            return evaluate(_value);
+        }
+
+        /**
+         * @brief evaluates the predicate for an array of values
+         *
+         * @param _values values to test
+         * @param _count number of values
+         * @param _results array of _count results
+         * @return number of values matching the predicate
+         */
+        size_t evaluate(const universal *_values, size_t _count, bool *_results) const
+        {
+            size_t matches = 0;
+            if (program.size() == 1)
+            {
+                // single comparison, no stack needed
+                const instruction_t &ins = program[0];
+                for (size_t i = 0; i < _count; i++)
+                    matches += (_results[i] = evaluate_compare(ins, _values[i]));
+            }
+            else
+            {
+                for (size_t i = 0; i < _count; i++)
+                    matches += (_results[i] = evaluate(_values[i]));
+            }
+            return matches;
+        }
+
+#ifdef __EL_ENABLE_CXX20
+        /**
+         * @brief evaluates the predicate for a span of values
+         *
+         * @param _values values to test
+         * @param _results results, must have the same size as _values
+         * @return number of values matching the predicate
+         */
+        size_t evaluate(std::span<const universal> _values, std::span<bool> _results) const
+        {
+            return evaluate(_values.data(), _values.size() < _results.size() ? _values.size() : _results.size(), _results.data());
+        }
+#endif
+    };
+};
+
+#endif  // __EL_ENABLE_CXX17
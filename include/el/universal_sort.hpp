@@ -0,0 +1,278 @@
+/*
+ELEKTRON © 2026 - now
+Written by melektron
+www.elektron.work
+16.10.26, 16:10
+All rights reserved.
+
+This source code is licensed under the Apache-2.0 license found in the
+LICENSE file in the root directory of this source tree.
+
+Total order sort keys for el::universal values and a radix sort based on them.
+
+universal's operator< compares strings by length and colors by brightness and is
+not a strict weak order across types, so it can't be used reliably for sorting.
+The sort key defines a total order instead:
+ 1. empty values
+ 2. numeric values (integer, floating, boolean as 0/1, rgb24 as packed integer)
+    ordered by their mathematical value, NaN after +infinity
+ 3. strings ordered lexicographically by their bytes
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <cstring>
+#include <cstddef>
+#include <algorithm>
+#include <vector>
+#include <iterator>
+#include <limits>
+#include <string_view>
+
+#include "cxxversions.h"
+#ifdef __EL_ENABLE_CXX17
+
+#ifdef __EL_ENABLE_CXX20
+#include <span>
+#endif
+
+#include "universal.hpp"
+
+namespace el
+{
+    /**
+     * @brief fixed width sort key of a universal value. Comparing keys
+     * gives the total order described in universal_sort.hpp, except for
+     * strings with a common prefix of 16 or more bytes, which compare equal.
+     */
+    struct universal_sort_key_t
+    {
+        uint8_t rank = 0;       // 0: empty, 1: numeric, 2: string
+        uint64_t primary = 0;   // numerics: order preserving double bits, strings: bytes 0-7 big endian
+        uint64_t secondary = 0; // numerics: order preserving rounding error of primary, strings: bytes 8-15 big endian
+
+        friend bool operator==(const universal_sort_key_t &_lhs, const universal_sort_key_t &_rhs) noexcept
+        {
+            return _lhs.rank == _rhs.rank && _lhs.primary == _rhs.primary && _lhs.secondary == _rhs.secondary;
+        }
+        friend bool operator!=(const universal_sort_key_t &_lhs, const universal_sort_key_t &_rhs) noexcept
+        {
+            return !(_lhs == _rhs);
+        }
+        friend bool operator<(const universal_sort_key_t &_lhs, const universal_sort_key_t &_rhs) noexcept
+        {
+            if (_lhs.rank != _rhs.rank)
+                return _lhs.rank < _rhs.rank;
+            if (_lhs.primary != _rhs.primary)
+                return _lhs.primary < _rhs.primary;
+            return _lhs.secondary < _rhs.secondary;
+        }
+    };
+
+    namespace sort_key_detail
+    {
+        constexpr uint64_t sign_bit = 0x8000000000000000ull;
+
+        /**
+         * @brief maps a double to an unsigned integer with the same order
+         */
+        inline uint64_t ordered_double(double _d) noexcept
+        {
+            if (_d != _d)
+                _d = std::numeric_limits<double>::quiet_NaN();  // positive quiet NaN sorts after +inf
+            if (_d == 0)
+                _d = 0;                     // -0.0 and 0.0 are the same value
+            uint64_t bits;
+            std::memcpy(&bits, &_d, sizeof(bits));
+            return (bits & sign_bit) ? ~bits : bits ^ sign_bit;
+        }
+
+        /**
+         * @brief maps an int64_t to an unsigned integer with the same order
+         */
+        inline uint64_t ordered_integer(int64_t _i) noexcept
+        {
+            return (uint64_t)_i ^ sign_bit;
+        }
+
+        /**
+         * @brief difference between an integer and its value rounded to a double
+         * (at most +-1024). Integers that round to the same double as another value
+         * are ordered by it, so the key order stays exact beyond 2^53.
+         */
+        inline int64_t rounding_error(int64_t _i, double _rounded) noexcept
+        {
+            if (_rounded >= 9223372036854775808.0)
+                return (_i - INT64_MAX) - 1;    // _i - 2^63 without overflow
+            return _i - (int64_t)_rounded;
+        }
+
+        /**
+         * @brief reads up to 8 bytes of a string as big endian integer, padded with zeros
+         */
+        inline uint64_t string_word(std::string_view _s, size_t _offset) noexcept
+        {
+            uint64_t w = 0;
+            for (size_t i = 0; i < 8; i++)
+            {
+                w <<= 8;
+                if (_offset + i < _s.size())
+                    w |= (uint8_t)_s[_offset + i];
+            }
+            return w;
+        }
+    };
+
+    /**
+     * @brief calculates the sort key of a universal value
+     */
+    template<typename _ST, typename _SP>
+    universal_sort_key_t universal_sort_key(const basic_universal<_ST, _SP> &_value) noexcept
+    {
+        using namespace sort_key_detail;
+        universal_sort_key_t key;
+        switch (_value.get_type())
+        {
+        case universal_type_t::floating:
+        {
+            double d = _value.to_double();
+            key.rank = 1;
+            key.primary = ordered_double(d);
+            key.secondary = ordered_integer(0);
+            break;
+        }
+
+        case universal_type_t::integer:
+        case universal_type_t::boolean:
+        case universal_type_t::rgb24:
+        {
+            int64_t i = _value.to_int64_t();
+            double d = (double)i;
+            key.rank = 1;
+            key.primary = ordered_double(d);
+            key.secondary = ordered_integer(rounding_error(i, d));
+            break;
+        }
+
+        case universal_type_t::string:
+        {
+            std::string_view s(_value.get_string());
+            key.rank = 2;
+            key.primary = string_word(s, 0);
+            key.secondary = string_word(s, 8);
+            break;
+        }
+
+        case universal_type_t::empty:
+        default:
+            break;
+        }
+        return key;
+    }
+
+    /**
+     * @brief sorts a range of universal values in the total order defined by
+     * universal_sort_key() using an LSD radix sort over the keys. Byte positions
+     * that are equal for all keys are skipped. Strings with equal key (common prefix
+     * of 16 bytes or more) are ordered by a full comparison afterwards.
+     * The sort is stable.
+     *
+     * @tparam _It random access iterator to basic_universal values
+     * @param _first begin of the range
+     * @param _last end of the range
+     */
+    template<typename _It>
+    void sort_universal(_It _first, _It _last)
+    {
+        using value_t = typename std::iterator_traits<_It>::value_type;
+        struct record_t
+        {
+            universal_sort_key_t key;
+            size_t index;
+        };
+
+        size_t n = std::distance(_first, _last);
+        if (n < 2)
+            return;
+
+        std::vector<record_t> records(n);
+        for (size_t i = 0; i < n; i++)
+            records[i] = {universal_sort_key(_first[i]), i};
+
+        if (n < 64)
+        {
+            std::stable_sort(records.begin(), records.end(), [](const record_t &_a, const record_t &_b) {
+                return _a.key < _b.key;
+            });
+        }
+        else
+        {
+            // digit d: 0-7 secondary bytes, 8-15 primary bytes, 16 rank (least significant first)
+            auto digit = [](const universal_sort_key_t &_k, int _d) -> uint8_t {
+                if (_d < 8)
+                    return (uint8_t)(_k.secondary >> (_d * 8));
+                if (_d < 16)
+                    return (uint8_t)(_k.primary >> ((_d - 8) * 8));
+                return _k.rank;
+            };
+
+            std::vector<record_t> buffer(n);
+            for (int d = 0; d < 17; d++)
+            {
+                size_t counts[256] = {0};
+                for (const record_t &r : records)
+                    counts[digit(r.key, d)]++;
+
+                // skip the pass if all records have the same digit
+                if (counts[digit(records[0].key, d)] == n)
+                    continue;
+
+                size_t offsets[256];
+                size_t sum = 0;
+                for (int b = 0; b < 256; b++)
+                {
+                    offsets[b] = sum;
+                    sum += counts[b];
+                }
+                for (const record_t &r : records)
+                    buffer[offsets[digit(r.key, d)]++] = r;
+                records.swap(buffer);
+            }
+        }
+
+        // order strings that share a 16 byte prefix by full comparison
+        for (size_t i = 0; i < n;)
+        {
+            size_t j = i + 1;
+            while (j < n && records[j].key == records[i].key)
+                j++;
+            if (records[i].key.rank == 2 && j - i > 1)
+            {
+                std::stable_sort(records.begin() + i, records.begin() + j, [&](const record_t &_a, const record_t &_b) {
+                    return _first[_a.index].get_string() < _first[_b.index].get_string();
+                });
+            }
+            i = j;
+        }
+
+        // apply the permutation
+        std::vector<value_t> sorted;
+        sorted.reserve(n);
+        for (const record_t &r : records)
+            sorted.push_back(std::move(_first[r.index]));
+        std::move(sorted.begin(), sorted.end(), _first);
+    }
+
+#ifdef __EL_ENABLE_CXX20
+    /**
+     * @brief sorts a span of universal values, see sort_universal(_It, _It)
+     */
+    inline void sort_universal(std::span<universal> _values)
+    {
+        sort_universal(_values.begin(), _values.end());
+    }
+#endif
+};
+
+#endif  // __EL_ENABLE_CXX17
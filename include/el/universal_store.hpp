@@ -0,0 +1,669 @@
+/*
+ELEKTRON © 2026 - now
+Written by melektron
+www.elektron.work
+16.10.26, 19:40
+All rights reserved.
+
+This source code is licensed under the Apache-2.0 license found in the
+LICENSE file in the root directory of this source tree.
+
+Persistent store of named el::universal values in a memory mapped file.
+
+File layout (all integers in native byte order):
+ - header (64 bytes): magic, version, slot count, position and size of the string log
+ - index: slot count entries of 112 bytes, an open addressing hash table of names.
+   Every entry holds the name and two value cells (type, payload, timestamp) of which
+   one is active. Numeric values are stored directly in the cell.
+ - string log: append-only area for string values (4 byte length + characters)
+
+Opening a store only maps the file and checks the header, nothing is parsed.
+
+Updates are crash-safe: A new value is written to the inactive cell of the entry
+(and strings to the end of the log) before the active cell index is switched with a
+single byte release store, which can't be reordered before the cell writes. A crash at
+any point leaves either the old or the new value.
+New names are written completely before the hash that makes the entry valid is published.
+To also survive power loss, open the store with _durable set, which flushes the
+written data to the file before switching. This costs two msync() calls per update of
+a numeric value and four per string (string data, log size, cell, switch), plus one
+more when the string log has to grow.
+
+Only the value and the timestamp are stored, units are not persisted.
+
+This header requires a POSIX platform (mmap).
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <cstring>
+#include <cstdio>
+#include <string>
+#include <atomic>
+
+#include "cxxversions.h"
+#ifdef __EL_ENABLE_CXX17
+
+#include <string_view>
+
+#if __has_include(<sys/mman.h>) && __has_include(<unistd.h>)
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "universal.hpp"
+#include "types.hpp"
+#include "retcode.hpp"
+
+namespace el
+{
+    /**
+     * @brief Memory mapped key-value store for universal values.
+     * See universal_store.hpp for the file format and consistency guarantees.
+     *
+     * The number of index slots is fixed when the file is created. The string log
+     * grows as needed and can be compacted with compact(), which rewrites the file
+     * to a temporary file and atomically replaces the original.
+     *
+     * @note The store is not thread-safe and a file must only be opened by one
+     * store object at a time.
+     */
+    class universal_store
+    {
+    public:
+        static constexpr size_t max_name_length = 56;
+
+    protected:
+        static constexpr char file_magic[8] = {'E', 'L', 'S', 'T', 'O', 'R', 'E', '1'};
+        static constexpr uint32_t file_version = 1;
+
+        struct header_t
+        {
+            char magic[8];
+            uint32_t version;
+            uint32_t slot_count;        // power of two
+            uint64_t log_offset;        // file offset of the string log
+            uint64_t log_capacity;      // size of the string log in bytes
+            uint64_t log_used;          // bytes of the log in use
+            uint64_t reserved[3];
+        };
+
+        struct cell_t
+        {
+            uint8_t type;               // universal_type_t
+            uint8_t reserved[3];
+            uint32_t length;            // string length
+            uint64_t payload;           // numeric value or string log offset
+            uint64_t timestamp;
+        };
+
+        struct entry_t
+        {
+            uint32_t hash;              // 0 marks an unused slot
+            uint8_t active;             // index of the active cell
+            uint8_t name_length;
+            uint16_t reserved;
+            char name[max_name_length];
+            cell_t cells[2];
+        };
+
+        static_assert(sizeof(header_t) == 64, "unexpected header size");
+        static_assert(sizeof(entry_t) == 112, "unexpected entry size");
+
+        int fd = -1;
+        uint8_t *map = nullptr;
+        size_t map_size = 0;
+        std::string file_path;
+        bool durable = false;
+
+        header_t *header() const noexcept
+        {
+            return (header_t *)map;
+        }
+
+        entry_t *entries() const noexcept
+        {
+            return (entry_t *)(map + sizeof(header_t));
+        }
+
+        /**
+         * @brief stores a field that makes previously written data visible (release).
+         * Neither the compiler nor the CPU may move the data writes after it, so
+         * readers and a crash never see the field before the data it refers to.
+         */
+        template<typename _T>
+        static void publish(_T &_field, _T _value) noexcept
+        {
+#ifdef __cpp_lib_atomic_ref
+            std::atomic_ref<_T>(_field).store(_value, std::memory_order_release);
+#else
+            std::atomic_thread_fence(std::memory_order_release);
+            *(volatile _T *)&_field = _value;
+#endif
+        }
+
+        /**
+         * @brief loads a field written with publish() (acquire)
+         */
+        template<typename _T>
+        static _T observe(const _T &_field) noexcept
+        {
+#ifdef __cpp_lib_atomic_ref
+            return std::atomic_ref<_T>(const_cast<_T &>(_field)).load(std::memory_order_acquire);
+#else
+            _T value = *(const volatile _T *)&_field;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return value;
+#endif
+        }
+
+        static uint32_t hash_name(std::string_view _name) noexcept
+        {
+            // FNV-1a
+            uint32_t h = 2166136261u;
+            for (char c : _name)
+            {
+                h ^= (uint8_t)c;
+                h *= 16777619u;
+            }
+            return h ? h : 1;
+        }
+
+        static uint64_t log_offset_for(uint32_t _slot_count) noexcept
+        {
+            return sizeof(header_t) + (uint64_t)_slot_count * sizeof(entry_t);
+        }
+
+        /**
+         * @brief flushes a range of the mapping to the file if the store is durable
+         */
+        void sync_range(const void *_begin, size_t _size) const noexcept
+        {
+            if (!durable)
+                return;
+            size_t page = (size_t)sysconf(_SC_PAGESIZE);
+            uintptr_t start = (uintptr_t)_begin & ~(uintptr_t)(page - 1);
+            msync((void *)start, (uintptr_t)_begin + _size - start, MS_SYNC);
+        }
+
+        /**
+         * @brief maps _size bytes of the open file
+         */
+        bool map_file(size_t _size) noexcept
+        {
+            void *p = mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (p == MAP_FAILED)
+                return false;
+            map = (uint8_t *)p;
+            map_size = _size;
+            return true;
+        }
+
+        void unmap() noexcept
+        {
+            if (map != nullptr)
+                munmap(map, map_size);
+            map = nullptr;
+            map_size = 0;
+        }
+
+        /**
+         * @return index of the entry for _name or of the first unused entry in
+         * its probe sequence, or the slot count if there is neither (index full)
+         */
+        uint32_t find_slot(std::string_view _name, uint32_t _hash) const noexcept
+        {
+            uint32_t mask = header()->slot_count - 1;
+            for (uint32_t i = 0; i <= mask; i++)
+            {
+                uint32_t index = (_hash + i) & mask;
+                const entry_t &e = entries()[index];
+                uint32_t entry_hash = observe(e.hash);
+                if (entry_hash == 0 || (entry_hash == _hash && std::string_view(e.name, e.name_length) == _name))
+                    return index;
+            }
+            return mask + 1;
+        }
+
+        /**
+         * @return the entry for _name or nullptr if it doesn't exist
+         */
+        entry_t *find_entry(std::string_view _name) const noexcept
+        {
+            if (map == nullptr || _name.size() > max_name_length)
+                return nullptr;
+            uint32_t index = find_slot(_name, hash_name(_name));
+            if (index == header()->slot_count || observe(entries()[index].hash) == 0)
+                return nullptr;
+            return entries() + index;
+        }
+
+        /**
+         * @brief makes sure that _size more bytes fit into the string log by growing the file
+         */
+        bool reserve_log(size_t _size) noexcept
+        {
+            header_t *h = header();
+            if (h->log_used + _size <= h->log_capacity)
+                return true;
+
+            uint64_t capacity = h->log_capacity ? h->log_capacity : 4096;
+            while (h->log_used + _size > capacity)
+                capacity *= 2;
+            size_t new_size = h->log_offset + capacity;
+            if (ftruncate(fd, (off_t)new_size) != 0)
+                return false;
+            unmap();
+            if (!map_file(new_size))
+                return false;
+            header()->log_capacity = capacity;
+            sync_range(map, sizeof(header_t));
+            return true;
+        }
+
+        /**
+         * @brief creates the cell for a value. Strings are appended to the log,
+         * which may remap the file.
+         */
+        bool make_cell(const universal &_value, cell_t &_cell) noexcept
+        {
+            cell_t c{};
+            c.type = (uint8_t)_value.get_type();
+            c.timestamp = _value.get_timestamp();
+            switch (_value.get_type())
+            {
+            case universal_type_t::integer:
+                c.payload = (uint64_t)_value.to_int64_t();
+                break;
+
+            case universal_type_t::floating:
+            {
+                double d = _value.to_double();
+                std::memcpy(&c.payload, &d, sizeof(d));
+                break;
+            }
+
+            case universal_type_t::boolean:
+                c.payload = _value.to_bool();
+                break;
+
+            case universal_type_t::rgb24:
+                c.payload = _value.to_rgb24_t().to_packed();
+                break;
+
+            case universal_type_t::string:
+            {
+                const std::string &s = _value.get_string();
+                if (s.size() > UINT32_MAX)
+                    return false;
+                // entries are 8 byte aligned so the length can be read directly
+                size_t size = (sizeof(uint32_t) + s.size() + 7) & ~(size_t)7;
+                if (!reserve_log(size))
+                    return false;
+                header_t *h = header();
+                uint8_t *dst = map + h->log_offset + h->log_used;
+                uint32_t len = (uint32_t)s.size();
+                std::memcpy(dst, &len, sizeof(len));
+                std::memcpy(dst + sizeof(len), s.data(), s.size());
+                sync_range(dst, size);
+                c.payload = h->log_used;
+                c.length = len;
+                h->log_used += size;
+                sync_range(&h->log_used, sizeof(h->log_used));
+                break;
+            }
+
+            default:
+                break;
+            }
+            _cell = c;
+            return true;
+        }
+
+        /**
+         * @brief converts a cell to a universal value
+         */
+        bool read_cell(const cell_t &_cell, universal &_out) const
+        {
+            switch ((universal_type_t)_cell.type)
+            {
+            case universal_type_t::integer:
+                _out = (int64_t)_cell.payload;
+                break;
+
+            case universal_type_t::floating:
+            {
+                double d;
+                std::memcpy(&d, &_cell.payload, sizeof(d));
+                _out = d;
+                break;
+            }
+
+            case universal_type_t::boolean:
+                _out = _cell.payload != 0;
+                break;
+
+            case universal_type_t::rgb24:
+                _out = types::rgb24_t((uint32_t)_cell.payload);
+                break;
+
+            case universal_type_t::string:
+            {
+                const header_t *h = header();
+                if (_cell.payload + sizeof(uint32_t) + _cell.length > h->log_used)
+                    return false;
+                const char *src = (const char *)map + h->log_offset + _cell.payload + sizeof(uint32_t);
+                _out = std::string_view(src, _cell.length);
+                break;
+            }
+
+            default:
+                _out.clear();
+                break;
+            }
+            _out.set_timestamp(_cell.timestamp);
+            return true;
+        }
+
+        /**
+         * @brief creates a new, empty store file
+         */
+        retcode create_file(const std::string &_path, uint32_t _slot_count, size_t _log_capacity)
+        {
+            fd = ::open(_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+            if (fd < 0)
+                return retcode::inv_path;
+
+            size_t size = log_offset_for(_slot_count) + _log_capacity;
+            if (ftruncate(fd, (off_t)size) != 0 || !map_file(size))
+            {
+                close();
+                return retcode::err;
+            }
+            header_t *h = header();
+            h->version = file_version;
+            h->slot_count = _slot_count;
+            h->log_offset = log_offset_for(_slot_count);
+            h->log_capacity = _log_capacity;
+            h->log_used = 0;
+            // the magic is written last, so a partially created file is rejected
+            msync(map, size, MS_SYNC);
+            std::memcpy(h->magic, file_magic, sizeof(file_magic));
+            msync(map, sizeof(header_t), MS_SYNC);
+            return retcode::ok;
+        }
+
+    public:
+        universal_store() = default;
+
+        ~universal_store()
+        {
+            close();
+        }
+
+        universal_store(const universal_store &) = delete;
+        universal_store &operator=(const universal_store &) = delete;
+
+        /**
+         * @brief opens a store file or creates it if it doesn't exist
+         *
+         * @param _path path of the file
+         * @param _slot_count number of index slots when creating the file, rounded up to a
+         * power of two. The store can hold at most this many names.
+         * @param _log_capacity initial size of the string log when creating the file
+         * @param _durable flush every update to the file before it becomes active
+         * @retval retcode::ok the store is open
+         * @retval retcode::inv_path the file can't be opened or created
+         * @retval retcode::invalid the file is not a valid store
+         * @retval retcode::err mapping the file failed
+         * @retval retcode::e_size the file doesn't exist and _slot_count is larger than 2^31
+         */
+        retcode open(const std::string &_path, uint32_t _slot_count = 4096, size_t _log_capacity = 1 << 16, bool _durable = false)
+        {
+            close();
+            file_path = _path;
+            durable = _durable;
+
+            fd = ::open(_path.c_str(), O_RDWR);
+            if (fd < 0)
+            {
+                // the slot count is rounded up to a power of two in 32 bits
+                if (_slot_count > ((uint32_t)1 << 31))
+                    return retcode::e_size;
+                uint32_t slots = 1;
+                while (slots < _slot_count)
+                    slots <<= 1;
+                return create_file(_path, slots, (_log_capacity + 7) & ~(size_t)7);
+            }
+
+            struct stat st;
+            if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(header_t) || !map_file((size_t)st.st_size))
+            {
+                close();
+                return retcode::invalid;
+            }
+
+            const header_t *h = header();
+            if (std::memcmp(h->magic, file_magic, sizeof(file_magic)) != 0
+                || h->version != file_version
+                || h->slot_count == 0 || (h->slot_count & (h->slot_count - 1)) != 0
+                || h->log_offset != log_offset_for(h->slot_count)
+                || h->log_used > h->log_capacity
+                || h->log_offset + h->log_capacity > map_size)
+            {
+                close();
+                return retcode::invalid;
+            }
+            return retcode::ok;
+        }
+
+        /**
+         * @brief unmaps and closes the file
+         */
+        void close() noexcept
+        {
+            unmap();
+            if (fd >= 0)
+                ::close(fd);
+            fd = -1;
+        }
+
+        bool is_open() const noexcept
+        {
+            return map != nullptr;
+        }
+
+        /**
+         * @brief stores a value under a name
+         *
+         * @retval retcode::ok the value was stored
+         * @retval retcode::e_size the name is too long or the index is full
+         * @retval retcode::err the string log could not be grown
+         * @retval retcode::invalid the store is not open
+         */
+        retcode set(std::string_view _name, const universal &_value)
+        {
+            if (map == nullptr)
+                return retcode::invalid;
+            if (_name.size() > max_name_length)
+                return retcode::e_size;
+            uint32_t hash = hash_name(_name);
+            uint32_t index = find_slot(_name, hash);
+            if (index == header()->slot_count)
+                return retcode::e_size;
+
+            cell_t cell;
+            if (!make_cell(_value, cell))
+                return retcode::err;
+
+            // make_cell() may have remapped the file
+            entry_t *e = entries() + index;
+            if (observe(e->hash) == 0)
+            {
+                // new entry: the value is written first, publishing the hash makes the entry valid
+                std::memset(e, 0, sizeof(*e));
+                std::memcpy(e->name, _name.data(), _name.size());
+                e->name_length = (uint8_t)_name.size();
+                e->cells[0] = cell;
+                sync_range(e, sizeof(*e));
+                publish(e->hash, hash);
+                sync_range(&e->hash, sizeof(e->hash));
+                return retcode::ok;
+            }
+
+            uint8_t next = e->active ^ 1;
+            e->cells[next] = cell;
+            sync_range(&e->cells[next], sizeof(cell_t));
+            publish(e->active, next);
+            sync_range(&e->active, sizeof(e->active));
+            return retcode::ok;
+        }
+
+        /**
+         * @brief reads the value stored under a name
+         *
+         * @param _name name of the value
+         * @param _out receives the value (with timestamp)
+         * @retval true the value was found
+         * @retval false there is no value with this name
+         */
+        bool get(std::string_view _name, universal &_out) const
+        {
+            const entry_t *e = find_entry(_name);
+            if (e == nullptr)
+                return false;
+            return read_cell(e->cells[observe(e->active) & 1], _out);
+        }
+
+        bool contains(std::string_view _name) const noexcept
+        {
+            return find_entry(_name) != nullptr;
+        }
+
+        /**
+         * @brief calls _fn(std::string_view name, const universal &value) for every stored value
+         */
+        template<typename _Fn>
+        void for_each(_Fn &&_fn) const
+        {
+            if (map == nullptr)
+                return;
+            universal value;
+            for (uint32_t i = 0; i < header()->slot_count; i++)
+            {
+                const entry_t &e = entries()[i];
+                if (observe(e.hash) != 0 && read_cell(e.cells[observe(e.active) & 1], value))
+                    _fn(std::string_view(e.name, e.name_length), (const universal &)value);
+            }
+        }
+
+        /**
+         * @return number of names in the store
+         */
+        size_t size() const noexcept
+        {
+            size_t n = 0;
+            if (map != nullptr)
+            {
+                for (uint32_t i = 0; i < header()->slot_count; i++)
+                    n += observe(entries()[i].hash) != 0;
+            }
+            return n;
+        }
+
+        /**
+         * @return number of bytes used in the string log, including old strings
+         * which are no longer referenced
+         */
+        size_t log_used() const noexcept
+        {
+            return map ? header()->log_used : 0;
+        }
+
+        /**
+         * @return number of bytes of the string log used by current values
+         */
+        size_t log_live() const noexcept
+        {
+            size_t n = 0;
+            if (map == nullptr)
+                return n;
+            for (uint32_t i = 0; i < header()->slot_count; i++)
+            {
+                const entry_t &e = entries()[i];
+                const cell_t &c = e.cells[observe(e.active) & 1];
+                if (observe(e.hash) != 0 && c.type == (uint8_t)universal_type_t::string)
+                    n += (sizeof(uint32_t) + c.length + 7) & ~(size_t)7;
+            }
+            return n;
+        }
+
+        /**
+         * @brief writes all changes to the file
+         */
+        retcode flush() noexcept
+        {
+            if (map == nullptr)
+                return retcode::invalid;
+            return msync(map, map_size, MS_SYNC) == 0 ? retcode::ok : retcode::err;
+        }
+
+        /**
+         * @brief removes strings no longer referenced from the log. The store is
+         * copied to a temporary file next to the original which then replaces the
+         * original file atomically, so a crash during compaction leaves the old file intact.
+         */
+        retcode compact()
+        {
+            if (map == nullptr)
+                return retcode::invalid;
+
+            std::string tmp_path = file_path + ".tmp";
+            universal_store tmp;
+            ::unlink(tmp_path.c_str());
+            // don't leave the temporary file behind on failure
+            auto discard = [&](retcode _code) {
+                tmp.close();
+                ::unlink(tmp_path.c_str());
+                return _code;
+            };
+
+            size_t live = log_live();
+            retcode code = tmp.create_file(tmp_path, header()->slot_count, live > 0 ? live : 8);
+            if (code != retcode::ok)
+                return discard(code);
+            tmp.file_path = tmp_path;
+
+            // copy all entries into the same slots so lookups stay valid
+            for (uint32_t i = 0; i < header()->slot_count; i++)
+            {
+                const entry_t &src = entries()[i];
+                if (observe(src.hash) == 0)
+                    continue;
+                universal value;
+                cell_t cell;
+                read_cell(src.cells[observe(src.active) & 1], value);
+                if (!tmp.make_cell(value, cell))
+                    return discard(retcode::err);
+                entry_t &dst = tmp.entries()[i];
+                dst = src;
+                dst.active = 0;
+                dst.cells[0] = cell;
+            }
+            if (tmp.flush() != retcode::ok || fsync(tmp.fd) != 0)
+                return discard(retcode::err);
+            tmp.close();
+
+            if (std::rename(tmp_path.c_str(), file_path.c_str()) != 0)
+                return discard(retcode::err);
+            return open(file_path, 0, 0, durable);
+        }
+    };
+};
+
+#endif  // __has_include(<sys/mman.h>)
+
+#endif  // __EL_ENABLE_CXX17